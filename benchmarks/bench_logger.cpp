@@ -0,0 +1,231 @@
+/**
+ * @file    bench_logger.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Cost of the logging calls, of MtSink and of the buffer dumps.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#include "fakes.h"
+#include "logger.h"
+#include "mini_printf.h"
+#include "mt_sink.h"
+#include "proxy_sink.h"
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace Logging {
+namespace {
+//! Sends every message to a CountingSink for as long as it exists.
+class CountingLogger {
+public:
+    explicit CountingLogger(Level level = Level::all)
+    {
+        Logger::addSink(m_sink);
+        Logger::setLevel(level);
+    }
+    CountingLogger(const CountingLogger&)            = delete;
+    CountingLogger& operator=(const CountingLogger&) = delete;
+    ~CountingLogger()
+    {
+        Logger::clearSinks();
+        Logger::clearLevel();
+    }
+
+    [[nodiscard]] std::size_t messages() const { return m_sink.messages; }
+
+private:
+    Fakes::CountingSink m_sink;
+};
+
+void BM_FilteredOutCall(benchmark::State& state)
+{
+    CountingLogger logger {Level::info};
+    int            i = 0;
+    for (auto _ : state) {
+        LOGD("BENCH", "value %d", i++);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FilteredOutCall);
+
+//! BM_FilteredOutCall without the call site's cache: the logger is looked up on every call, like before the cache.
+void BM_FilteredOutCallLookup(benchmark::State& state)
+{
+    CountingLogger logger {Level::info};
+    // A few tags with a configuration of their own, for the lookup to go through.
+    for (const char* tag : {"BENCH", "MOTOR", "USB", "FS"}) {
+        Logger::setLevel(tag, Level::info);
+    }
+    int i = 0;
+    for (auto _ : state) {
+        Logger::ReadGuard guard;
+        if (Logger::getLogger(guard, "BENCH").admit(Level::debug)) {
+            LOGGER_LOG_HELPER_IMPL(Logger::getLogger(guard, "BENCH"), Level::debug, "value %d", i);
+        }
+        i++;
+    }
+    for (const char* tag : {"BENCH", "MOTOR", "USB", "FS"}) {
+        Logger::clearLevel(tag);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FilteredOutCallLookup);
+
+void BM_FormattedCall(benchmark::State& state)
+{
+    CountingLogger logger;
+    int            i = 0;
+    for (auto _ : state) {
+        LOGI("BENCH", "value %d of %s", i++, "the benchmark");
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FormattedCall);
+
+void BM_FormattedCallChecked(benchmark::State& state)
+{
+    CountingLogger logger;
+    int            i = 0;
+    for (auto _ : state) {
+        LOGI_F("BENCH", "value {} of {}", i++, "the benchmark");
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FormattedCallChecked);
+
+Fakes::CountingSink                s_mtTarget;
+std::unique_ptr<MtSink<ProxySink>> s_mtSink;
+
+void setUpMtSink(const benchmark::State& /*state*/)
+{
+    s_mtSink = std::make_unique<MtSink<ProxySink>>(&s_mtTarget);
+    Logger::addSink(*s_mtSink);
+    // Let the sink's task start, it discards the messages until then.
+    vTaskDelay(pdMS_TO_TICKS(10));
+}
+
+void tearDownMtSink(const benchmark::State& /*state*/)
+{
+    Logger::clearSinks();
+    s_mtSink.reset();
+}
+
+//! Time a producer spends queuing a message, including the waits for room when the consumer falls behind.
+void BM_MtSinkProducer(benchmark::State& state)
+{
+    int i = 0;
+    for (auto _ : state) {
+        LOGI("BENCH", "value %d of %s", i++, "the benchmark");
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MtSinkProducer)->Setup(&setUpMtSink)->Teardown(&tearDownMtSink)->ThreadRange(1, 4)->UseRealTime();
+
+//! Messages per second going through MtSink, from the first being queued to the last reaching the real sink.
+void BM_MtSinkThroughput(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        const std::size_t target = s_mtTarget.messages + count;
+        for (std::size_t i = 0; i < count; i++) {
+            LOGI("BENCH", "value %d of %s", static_cast<int>(i), "the benchmark");
+        }
+        while (s_mtTarget.messages < target) {
+            std::this_thread::yield();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(count));
+}
+BENCHMARK(BM_MtSinkThroughput)->Setup(&setUpMtSink)->Teardown(&tearDownMtSink)->Arg(1000)->UseRealTime();
+
+std::vector<std::uint8_t> makeDumpInput(const benchmark::State& state)
+{
+    std::vector<std::uint8_t> buffer(static_cast<std::size_t>(state.range(0)));
+    for (std::size_t i = 0; i < buffer.size(); i++) {
+        buffer[i] = static_cast<std::uint8_t>(i);
+    }
+    return buffer;
+}
+
+// The dumps go from 64 bytes to 64 KiB.
+void dumpSizes(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->RangeMultiplier(4)->Range(64, 64 << 10);
+}
+
+void BM_BufferHex(benchmark::State& state)
+{
+    CountingLogger logger;
+    const auto     buffer = makeDumpInput(state);
+    for (auto _ : state) {
+        LOG_BUFFER_HEX("BENCH", buffer.data(), buffer.size());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(buffer.size()));
+}
+BENCHMARK(BM_BufferHex)->Apply(&dumpSizes);
+
+//! BM_BufferHex rendered the way it was before the lookup table: a printf call per byte and a message per line.
+void BM_BufferHexPerByte(benchmark::State& state)
+{
+    constexpr std::size_t s_bytesPerLine = 16;
+
+    CountingLogger logger;
+    const auto     buffer = makeDumpInput(state);
+    for (auto _ : state) {
+        for (std::size_t offset = 0; offset < buffer.size(); offset += s_bytesPerLine) {
+            char              line[3 * s_bytesPerLine + 1];
+            const std::size_t lineLength = std::min(s_bytesPerLine, buffer.size() - offset);
+            for (std::size_t i = 0; i < lineLength; i++) {
+                Printf::format(&line[3 * i], sizeof(line) - 3 * i, "%02x ", buffer[offset + i]);
+            }
+            LOGI("BENCH", "%s", &line[0]);
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(buffer.size()));
+}
+BENCHMARK(BM_BufferHexPerByte)->Apply(&dumpSizes);
+
+void BM_BufferChar(benchmark::State& state)
+{
+    CountingLogger logger;
+    const auto     buffer = makeDumpInput(state);
+    for (auto _ : state) {
+        LOG_BUFFER_CHAR("BENCH", buffer.data(), buffer.size());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(buffer.size()));
+}
+BENCHMARK(BM_BufferChar)->Apply(&dumpSizes);
+
+void BM_BufferHexdump(benchmark::State& state)
+{
+    CountingLogger logger;
+    const auto     buffer = makeDumpInput(state);
+    for (auto _ : state) {
+        LOG_BUFFER_HEXDUMP("BENCH", buffer.data(), buffer.size());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(buffer.size()));
+}
+BENCHMARK(BM_BufferHexdump)->Apply(&dumpSizes);
+}    // namespace
+}    // namespace Logging
+
+BENCHMARK_MAIN();
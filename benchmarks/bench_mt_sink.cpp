@@ -0,0 +1,139 @@
+/**
+ * @file    bench_mt_sink.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Benchmarks of the queues and overflow strategies of MtSink.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#include "fakes.h"
+#include "logger.h"
+#include "mt_sink.h"
+#include "priority_ring.h"
+#include "proxy_sink.h"
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+namespace Logging {
+namespace {
+using namespace std::chrono_literals;
+
+/**
+ * Time for an error to reach a slow sink when it is logged behind a burst of traces, with the given queue. The sink
+ * takes state.range(1) microseconds per message, the burst holds state.range(0) traces.
+ */
+template<template<std::size_t> class Queue>
+void BM_ErrorLatencyBehindTraces(benchmark::State& state)
+{
+    const auto                     traces = static_cast<int>(state.range(0));
+    Fakes::SlowSink                target {std::chrono::microseconds(state.range(1))};
+    MtSink<ProxySink, 8192, Queue> sink {&target};
+    Logger::addSink(sink);
+    // Let the sink's task start, it discards the messages until then.
+    vTaskDelay(pdMS_TO_TICKS(10));
+
+    for (auto _ : state) {
+        const std::size_t targetMessages = target.messages + static_cast<std::size_t>(traces) + 1;
+        for (int i = 0; i < traces; i++) {
+            LOGT("BENCH", "trace %d", i);
+        }
+        const auto start = Fakes::SlowSink::Clock::now();
+        LOGE("BENCH", "error");
+        while (target.lastError.load() < start) {
+            std::this_thread::sleep_for(10us);
+        }
+        state.SetIterationTime(std::chrono::duration<double>(target.lastError.load() - start).count());
+        // Start the next burst with an empty queue.
+        while (target.messages.load(std::memory_order_acquire) < targetMessages) {
+            std::this_thread::sleep_for(100us);
+        }
+    }
+    Logger::clearSinks();
+}
+BENCHMARK(BM_ErrorLatencyBehindTraces<MpscRing>)->Args({60, 300})->Iterations(20)->UseManualTime();
+BENCHMARK(BM_ErrorLatencyBehindTraces<Priorities<Level::warning>::Ring>)
+  ->Args({60, 300})
+  ->Iterations(20)
+  ->UseManualTime();
+template<OverflowStrategy Strategy>
+struct StrategyPolicy : MtSinkPolicy {
+    static constexpr OverflowStrategy overflow = Strategy;
+};
+
+std::size_t droppedMessages(const Sink& sink)
+{
+    const SinkStats::Snapshot stats = sink.snapshotStats();
+    std::size_t               total = 0;
+    for (std::size_t i = 0; i < SinkStats::s_dropCauseCount; i++) {
+        total += stats.droppedBy(static_cast<DropCause>(i));
+    }
+    return total;
+}
+
+/**
+ * A burst of state.range(0) info messages, logged as fast as possible to a ring of 2048 bytes drained by a sink that
+ * takes state.range(1) microseconds per message. The time is the producer's, per burst. The counters give the share
+ * of the burst that was delivered and dropped.
+ */
+template<OverflowStrategy Strategy>
+void BM_OverflowStrategy(benchmark::State& state)
+{
+    const auto      burst = static_cast<std::size_t>(state.range(0));
+    Fakes::SlowSink target {std::chrono::microseconds(state.range(1))};
+    MtSink<ProxySink, 2048, MpscRing, StrategyPolicy<Strategy>> sink {&target};
+    Logger::addSink(sink);
+    // Let the sink's task start, it discards the messages until then.
+    vTaskDelay(pdMS_TO_TICKS(10));
+
+    std::size_t delivered = 0;
+    std::size_t dropped   = 0;
+    for (auto _ : state) {
+        const std::size_t messagesBefore = target.messages - target.errors;
+        const std::size_t droppedBefore  = droppedMessages(sink);
+        const auto        start          = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < burst; i++) {
+            LOGI("BENCH", "message %u of the burst", static_cast<unsigned>(i));
+        }
+        state.SetIterationTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+        // Every message of the burst ends up delivered or dropped, the drop reports are errors.
+        std::size_t burstDelivered = 0;
+        std::size_t burstDropped   = 0;
+        do {
+            std::this_thread::sleep_for(1ms);
+            burstDelivered = target.messages - target.errors - messagesBefore;
+            burstDropped   = droppedMessages(sink) - droppedBefore;
+        } while (burstDelivered + burstDropped < burst);
+        delivered += burstDelivered;
+        dropped += burstDropped;
+    }
+    Logger::clearSinks();
+
+    const auto total            = static_cast<double>(state.iterations() * burst);
+    state.counters["delivered"] = static_cast<double>(delivered) / total;
+    state.counters["dropped"]   = static_cast<double>(dropped) / total;
+}
+BENCHMARK(BM_OverflowStrategy<OverflowStrategy::block>)->Args({500, 20})->Iterations(10)->UseManualTime();
+BENCHMARK(BM_OverflowStrategy<OverflowStrategy::dropNewest>)->Args({500, 20})->Iterations(10)->UseManualTime();
+BENCHMARK(BM_OverflowStrategy<OverflowStrategy::dropOldest>)->Args({500, 20})->Iterations(10)->UseManualTime();
+BENCHMARK(BM_OverflowStrategy<OverflowStrategy::sample>)->Args({500, 20})->Iterations(10)->UseManualTime();
+}    // namespace
+}    // namespace Logging
+
+BENCHMARK_MAIN();
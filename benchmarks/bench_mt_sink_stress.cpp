@@ -0,0 +1,79 @@
+/**
+ * @file    bench_mt_sink_stress.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Stress benchmark of MtSink over a sweep of message lengths and ring sizes.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "mt_sink.h"
+#include "proxy_sink.h"
+#include "stress_harness.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+
+namespace Logging {
+namespace {
+template<std::size_t MaxLength>
+struct StressPolicy : MtSinkPolicy {
+    static constexpr std::size_t messageMaxLength = MaxLength;
+};
+
+/**
+ * 4 producer tasks and a simulated interrupt logging through an MtSink with a ring of BufferSize bytes, dropping the
+ * messages longer than MaxLength. The payloads are 16 to 160 characters, after a prefix of about 20. The time is the
+ * whole run's; the latencies are in nanoseconds.
+ */
+template<std::size_t MaxLength, std::size_t BufferSize>
+void BM_Stress(benchmark::State& state)
+{
+    Stress::Config config;
+    config.producers           = 4;
+    config.messagesPerProducer = 5000;
+    config.isrMessages         = 1000;
+    config.isrPeriod           = std::chrono::microseconds(50);
+
+    Stress::Result result;
+    for (auto _ : state) {
+        result = Stress::run<MtSink<ProxySink, BufferSize, MpscRing, StressPolicy<MaxLength>>>(config);
+        state.SetIterationTime(result.seconds);
+    }
+
+    state.counters["producer_p50"] = static_cast<double>(result.producer.p50);
+    state.counters["producer_p99"] = static_cast<double>(result.producer.p99);
+    state.counters["producer_max"] = static_cast<double>(result.producer.max);
+    state.counters["e2e_p50"]      = static_cast<double>(result.endToEnd.p50);
+    state.counters["e2e_p99"]      = static_cast<double>(result.endToEnd.p99);
+    state.counters["e2e_max"]      = static_cast<double>(result.endToEnd.max);
+    state.counters["msgs_per_s"]   = result.throughput();
+    state.counters["drop_rate"]    = result.dropRate();
+    state.counters["isr_drops"]    = static_cast<double>(result.droppedIsr);
+    state.counters["lost"]         = static_cast<double>(result.lost);
+    state.counters["out_of_order"] = static_cast<double>(result.outOfOrder);
+    state.counters["corrupted"]    = static_cast<double>(result.corrupted);
+    if (result.lost != 0 || result.outOfOrder != 0 || result.corrupted != 0) {
+        state.SkipWithError("Messages were lost, reordered or corrupted");
+    }
+}
+#define LOGGER_BENCH_STRESS(maxLength)                                                                                 \
+    BENCHMARK_TEMPLATE(BM_Stress, maxLength, 1024)->Iterations(1)->UseManualTime()->Unit(benchmark::kMillisecond);    \
+    BENCHMARK_TEMPLATE(BM_Stress, maxLength, 4096)->Iterations(1)->UseManualTime()->Unit(benchmark::kMillisecond);    \
+    BENCHMARK_TEMPLATE(BM_Stress, maxLength, 16384)->Iterations(1)->UseManualTime()->Unit(benchmark::kMillisecond);
+
+LOGGER_BENCH_STRESS(64)
+LOGGER_BENCH_STRESS(128)
+LOGGER_BENCH_STRESS(256)
+}    // namespace
+}    // namespace Logging
+
+BENCHMARK_MAIN();
@@ -0,0 +1,102 @@
+/**
+ * @file    bench_printf.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Benchmarks of the printf subset against the libc one.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#include "format.h"
+#include "mini_printf.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdarg>
+#include <cstdio>
+
+namespace Logging {
+namespace {
+//! How the messages were formatted with LOGGER_USE_LIBC_PRINTF, through a va_list.
+[[gnu::format(printf, 3, 4)]] int libcFormat(char* buffer, std::size_t size, const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    const int length = std::vsnprintf(buffer, size, fmt, args);
+    va_end(args);
+    return length;
+}
+
+// A typical message prefix and a few typical payloads, with the printf format string and its LOGx_F equivalent.
+#define LOGGER_BENCH_PRINTF_CASES(X)                                                                                   \
+    X(Integers,                                                                                                        \
+      "I (%05lu) [%s] speed %d rpm, %u errors",                                                                        \
+      "I ({:05}) [{}] speed {} rpm, {} errors",                                                                        \
+      123456UL,                                                                                                        \
+      "MOTOR",                                                                                                         \
+      -1500,                                                                                                           \
+      3U)                                                                                                              \
+    X(Hex,                                                                                                             \
+      "I (%05lu) [%s] reg 0x%08x = %#x",                                                                               \
+      "I ({:05}) [{}] reg 0x{:08x} = {:#x}",                                                                           \
+      123456UL,                                                                                                        \
+      "SPI",                                                                                                           \
+      0xdeadbeefU,                                                                                                     \
+      0x42U)                                                                                                           \
+    X(String,                                                                                                          \
+      "I (%05lu) [%s] state %-12s -> %s",                                                                              \
+      "I ({:05}) [{}] state {:<12} -> {}",                                                                             \
+      123456UL,                                                                                                        \
+      "FSM",                                                                                                           \
+      "idle",                                                                                                          \
+      "running")                                                                                                       \
+    X(Float,                                                                                                           \
+      "I (%05lu) [%s] temperature %.2f C, ratio %f",                                                                   \
+      "I ({:05}) [{}] temperature {:.2f} C, ratio {:.6f}",                                                             \
+      123456UL,                                                                                                        \
+      "ADC",                                                                                                           \
+      23.456,                                                                                                          \
+      0.125)
+
+#define LOGGER_BENCH_PRINTF(name, printfFmt, formatFmt, ...)                                                           \
+    void BM_MiniPrintf##name(benchmark::State& state)                                                                  \
+    {                                                                                                                  \
+        char buffer[128];                                                                                              \
+        for (auto _ : state) {                                                                                         \
+            benchmark::DoNotOptimize(Printf::format(buffer, sizeof(buffer), printfFmt, __VA_ARGS__));                  \
+            benchmark::ClobberMemory();                                                                                \
+        }                                                                                                              \
+    }                                                                                                                  \
+    BENCHMARK(BM_MiniPrintf##name);                                                                                    \
+    void BM_Vsnprintf##name(benchmark::State& state)                                                                   \
+    {                                                                                                                  \
+        char buffer[128];                                                                                              \
+        for (auto _ : state) {                                                                                         \
+            benchmark::DoNotOptimize(libcFormat(buffer, sizeof(buffer), printfFmt, __VA_ARGS__));                      \
+            benchmark::ClobberMemory();                                                                                \
+        }                                                                                                              \
+    }                                                                                                                  \
+    BENCHMARK(BM_Vsnprintf##name);                                                                                     \
+    void BM_Format##name(benchmark::State& state)                                                                      \
+    {                                                                                                                  \
+        char buffer[128];                                                                                              \
+        for (auto _ : state) {                                                                                         \
+            benchmark::DoNotOptimize(Format::formatTo<formatFmt>(buffer, sizeof(buffer), __VA_ARGS__));                \
+            benchmark::ClobberMemory();                                                                                \
+        }                                                                                                              \
+    }                                                                                                                  \
+    BENCHMARK(BM_Format##name);
+
+LOGGER_BENCH_PRINTF_CASES(LOGGER_BENCH_PRINTF)
+}    // namespace
+}    // namespace Logging
+
+BENCHMARK_MAIN();
@@ -0,0 +1,95 @@
+/**
+ * @file    bench_uart_sinks.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Benchmarks of the blocking and DMA-driven UART sinks, on the fake HAL.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "colors.h"
+#include "dma_uart_sink.h"
+#include "uart_sink.h"
+#include "usart.h"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace Logging {
+namespace {
+using namespace std::chrono_literals;
+
+constexpr std::uint32_t s_baudRate = 921'600;
+
+UART_HandleTypeDef  g_uart;
+HalUartDmaTransport g_dmaTransport {&g_uart};
+
+/**
+ * Bursts of state.range(0) info messages of state.range(1) characters, written straight to the sink. The time is the
+ * writer's, per burst; the wire is left to go idle between the bursts. The counter is the number of UART transfers
+ * per burst.
+ */
+void runBursts(benchmark::State& state, Sink& sink)
+{
+    const auto        burst = static_cast<std::size_t>(state.range(0));
+    const std::string text(static_cast<std::size_t>(state.range(1)), 'x');
+    const std::size_t burstBytes =
+      burst * (colorStrFromLevel(Level::info).size() + text.size() + s_resetColor.size());
+
+    g_uart.baudRate = s_baudRate;
+    g_uart.tx.clear();
+    g_uart.tx.setKeepBytes(false);
+    for (auto _ : state) {
+        const std::size_t sentBefore = g_uart.tx.byteCount();
+        const auto        start      = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < burst; i++) {
+            sink.onWrite(Level::info, text.data(), text.size());
+        }
+        state.SetIterationTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+        while (g_uart.tx.byteCount() < sentBefore + burstBytes || g_uart.dmaBusy) {
+            std::this_thread::sleep_for(100us);
+        }
+    }
+    // Let the last completion interrupt return before the sink goes away.
+    std::this_thread::sleep_for(1ms);
+
+    state.counters["transfers"] = benchmark::Counter(static_cast<double>(g_uart.tx.transferCount()),
+                                                     benchmark::Counter::kAvgIterations);
+}
+
+void BM_BlockingUartSink(benchmark::State& state)
+{
+    UartSink sink(&g_uart);
+    runBursts(state, sink);
+}
+BENCHMARK(BM_BlockingUartSink)->Args({4, 32})->Args({16, 32})->Iterations(20)->UseManualTime();
+
+void BM_DmaUartSink(benchmark::State& state)
+{
+    DmaUartSink sink(g_dmaTransport);
+    runBursts(state, sink);
+}
+// The first message of a burst is sent right away, the next 3 wait in the other buffer. 16 messages don't fit: the
+// writer then waits for the wire.
+BENCHMARK(BM_DmaUartSink)->Args({4, 32})->Args({16, 32})->Iterations(20)->UseManualTime();
+}    // namespace
+}    // namespace Logging
+
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef* huart)
+{
+    if (huart == &Logging::g_uart) { Logging::g_dmaTransport.onTransmitComplete(); }
+}
+
+BENCHMARK_MAIN();
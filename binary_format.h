@@ -0,0 +1,305 @@
+/**
+ * @file    binary_format.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Encoder for the deferred (binary) logging mode.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef VENDOR_LOGGING_BINARY_FORMAT_H
+#define VENDOR_LOGGING_BINARY_FORMAT_H
+
+#include "level.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+//! Prefix of the sections holding the format strings. They don't need to be loaded on the target, see the README.
+#define LOGGER_BINARY_FORMAT_SECTION "logger_fmt"
+
+#define LOGGER_BINARY_STRINGIFY_IMPL(x) #x
+#define LOGGER_BINARY_STRINGIFY(x)      LOGGER_BINARY_STRINGIFY_IMPL(x)
+
+namespace Logging::Binary {
+//! First byte of every frame. Never emitted by the text sinks, which only send ASCII around the frames.
+static constexpr std::uint8_t s_syncByte = 0xA5;
+//! sync[1] + length[2] before the payload, checksum[1] after it.
+static constexpr std::size_t s_frameOverhead = 4;
+//! Size of a whole sequence record, frame included.
+static constexpr std::size_t s_sequenceFrameSize = s_frameOverhead + 1 + sizeof(std::uint32_t);
+//! Size of a whole dropped record, frame included.
+static constexpr std::size_t s_droppedFrameSize = s_frameOverhead + 1 + sizeof(std::uint64_t) + sizeof(std::uint32_t);
+
+enum class RecordType : std::uint8_t {
+    message       = 1,    //!< printf-style format string.
+    formatMessage = 2,    //!< std::format-style format string, see format.h.
+    blob          = 3,    //!< Raw bytes of a buffer dump, rendered by the host.
+    clockInfo     = 4,    //!< Frequency of the timestamps, sent before the first record.
+    sequence      = 5,    //!< Number of the record that follows, from the sinks whose queue reorders them.
+    dropped       = 6,    //!< Number of messages an MtSink had to drop since its last report.
+};
+
+//! How a buffer dump is shown, see Logger::writeHexArray and friends.
+enum class DumpKind : std::uint8_t {
+    hex     = 0,
+    chars   = 1,
+    hexdump = 2,
+};
+
+/**
+ * Type of an argument in a message record. The low nibble of the integer and pointer types holds their size in bytes.
+ */
+enum class ArgType : std::uint8_t {
+    signedInt   = 0x10,
+    unsignedInt = 0x20,
+    floating    = 0x30,    //!< Always sent as a double, like varargs would.
+    pointer     = 0x40,
+    string      = 0x50,    //!< Followed by a length byte and the characters, without the null terminator.
+};
+
+/**
+ * Serializes a record into a caller-provided buffer.
+ *
+ * Frame layout (native byte order):
+ *
+ *      sync[1] length[2] payload[length] checksum[1]
+ *
+ * Message payload:
+ *
+ *      type[1] level[1] timestamp[8] formatId[4] tagLength[1] tag[tagLength] (argType[1] value[...])...
+ *
+ * Blob payload:
+ *
+ *      type[1] level[1] timestamp[8] kind[1] addressSize[1] address[addressSize] tagLength[1] tag[tagLength]
+ *      length[2] data[length]
+ *
+ * Clock info payload:
+ *
+ *      type[1] ticksPerSecond[8]
+ *
+ * Sequence payload:
+ *
+ *      type[1] sequence[4]
+ *
+ * Dropped payload:
+ *
+ *      type[1] timestamp[8] count[4]
+ *
+ * The timestamps are the raw values of the clock given to Logger::setClock, converted by the host.
+ *
+ * The checksum is the xor of every payload byte, it allows the decoder to resync on a damaged stream.
+ */
+class Encoder {
+    char*       m_buffer;
+    std::size_t m_size;
+    std::size_t m_length   = 3;    // Room for the sync byte and the length.
+    bool        m_overflow = false;
+    //! Characters left for the string arguments, see message().
+    std::size_t m_stringRoom = SIZE_MAX;
+
+public:
+    Encoder(char* buffer, std::size_t size) : m_buffer(buffer), m_size(size) {}
+
+    /**
+     * The string arguments are truncated to fit in the buffer, the first ones getting the room they need first. The
+     * record only overflows if the other fields alone don't fit.
+     */
+    template<typename... Args>
+    void message(RecordType      type,
+                 Level           level,
+                 std::uint64_t   timestamp,
+                 std::uint32_t   formatId,
+                 std::string_view tag,
+                 const Args&... args)
+    {
+        const std::size_t fixedSize = s_frameOverhead + 1 + 1 + 8 + 4 + 1 +
+                                      std::min<std::size_t>(tag.size(), UINT8_MAX) + (argSize<Args>() + ... + 0);
+        m_stringRoom = m_size > fixedSize ? m_size - fixedSize : 0;
+
+        put(static_cast<std::uint8_t>(type));
+        put(static_cast<std::uint8_t>(level));
+        put(timestamp);
+        put(formatId);
+        putString(tag);
+        (arg(args), ...);
+    }
+
+    /**
+     * @param address Address of the first byte, shown by the hexdump view.
+     */
+    void blob(Level               level,
+              std::uint64_t       timestamp,
+              DumpKind            kind,
+              std::uintptr_t      address,
+              std::string_view    tag,
+              const std::uint8_t* data,
+              std::uint16_t       length)
+    {
+        put(static_cast<std::uint8_t>(RecordType::blob));
+        put(static_cast<std::uint8_t>(level));
+        put(timestamp);
+        put(static_cast<std::uint8_t>(kind));
+        put(static_cast<std::uint8_t>(sizeof(address)));
+        put(address);
+        putString(tag);
+        put(length);
+        write(data, length);
+    }
+
+    void clockInfo(std::uint64_t ticksPerSecond)
+    {
+        put(static_cast<std::uint8_t>(RecordType::clockInfo));
+        put(ticksPerSecond);
+    }
+
+    void sequence(std::uint32_t number)
+    {
+        put(static_cast<std::uint8_t>(RecordType::sequence));
+        put(number);
+    }
+
+    void dropped(std::uint64_t timestamp, std::uint32_t count)
+    {
+        put(static_cast<std::uint8_t>(RecordType::dropped));
+        put(timestamp);
+        put(count);
+    }
+
+    //! Largest blob that fits in a frame of `size` bytes.
+    static constexpr std::size_t blobCapacity(std::size_t size, std::string_view tag)
+    {
+        const std::size_t overhead = s_frameOverhead + 1 + 1 + 8 + 1 + 1 + sizeof(std::uintptr_t) + 1 +
+                                     std::min<std::size_t>(tag.size(), UINT8_MAX) + 2;
+        return size > overhead ? std::min<std::size_t>(size - overhead, UINT16_MAX) : 0;
+    }
+
+    /**
+     * Completes the frame.
+     * @return The size of the frame, or 0 if it didn't fit in the buffer.
+     */
+    std::size_t finish()
+    {
+        if (m_overflow || m_length + 1 > m_size || m_length - 3 > UINT16_MAX) { return 0; }
+
+        auto payloadLength = static_cast<std::uint16_t>(m_length - 3);
+        m_buffer[0]        = static_cast<char>(s_syncByte);
+        std::memcpy(&m_buffer[1], &payloadLength, sizeof(payloadLength));
+
+        std::uint8_t checksum = 0;
+        for (std::size_t i = 3; i < m_length; i++) {
+            checksum ^= static_cast<std::uint8_t>(m_buffer[i]);
+        }
+        m_buffer[m_length] = static_cast<char>(checksum);
+        return m_length + 1;
+    }
+
+private:
+    template<typename T>
+    void arg(const T& value)
+    {
+        using U = std::remove_cvref_t<T>;
+        if constexpr (std::is_same_v<U, bool>) { arg(static_cast<std::uint8_t>(value)); }
+        else if constexpr (std::is_enum_v<U>) {
+            arg(static_cast<std::underlying_type_t<U>>(value));
+        }
+        else if constexpr (std::is_integral_v<U>) {
+            constexpr auto type = std::is_signed_v<U> ? ArgType::signedInt : ArgType::unsignedInt;
+            put(static_cast<std::uint8_t>(static_cast<std::uint8_t>(type) | sizeof(U)));
+            put(value);
+        }
+        else if constexpr (std::is_floating_point_v<U>) {
+            put(static_cast<std::uint8_t>(ArgType::floating));
+            put(static_cast<double>(value));
+        }
+        else if constexpr (std::is_convertible_v<const U&, const char*>) {
+            const char* str = value;
+            put(static_cast<std::uint8_t>(ArgType::string));
+            const std::string_view string = str != nullptr ? std::string_view {str} : std::string_view {"(null)"};
+            const std::size_t      length = std::min(string.size(), m_stringRoom);
+            m_stringRoom -= length;
+            putString(string.substr(0, length));
+        }
+        else if constexpr (std::is_pointer_v<U> || std::is_null_pointer_v<U>) {
+            put(static_cast<std::uint8_t>(static_cast<std::uint8_t>(ArgType::pointer) | sizeof(std::uintptr_t)));
+            put(reinterpret_cast<std::uintptr_t>(value));
+        }
+        else {
+            static_assert(sizeof(U) == 0, "Unsupported argument type for binary logging");
+        }
+    }
+
+    //! Bytes taken by an argument in a message record, its characters excepted for a string.
+    template<typename T>
+    static constexpr std::size_t argSize()
+    {
+        using U = std::remove_cvref_t<T>;
+        if constexpr (std::is_same_v<U, bool>) { return 1 + 1; }
+        else if constexpr (std::is_enum_v<U>) {
+            return argSize<std::underlying_type_t<U>>();
+        }
+        else if constexpr (std::is_integral_v<U>) {
+            return 1 + sizeof(U);
+        }
+        else if constexpr (std::is_floating_point_v<U>) {
+            return 1 + sizeof(double);
+        }
+        else if constexpr (std::is_convertible_v<const U&, const char*>) {
+            return 1 + 1;
+        }
+        else {
+            return 1 + sizeof(std::uintptr_t);
+        }
+    }
+
+    template<typename T>
+    void put(const T& value)
+    {
+        write(&value, sizeof(T));
+    }
+
+    void putString(std::string_view str)
+    {
+        auto length = static_cast<std::uint8_t>(std::min<std::size_t>(str.size(), UINT8_MAX));
+        put(length);
+        write(str.data(), length);
+    }
+
+    void write(const void* data, std::size_t length)
+    {
+        if (m_length + length > m_size) {
+            m_overflow = true;
+            return;
+        }
+        std::memcpy(&m_buffer[m_length], data, length);
+        m_length += length;
+    }
+};
+}    // namespace Logging::Binary
+
+/**
+ * Places a format string in a format section and evaluates to its ID, which is its address. Only the ID goes on the
+ * wire, the host decoder fetches the string back from the ELF file.
+ *
+ * Each call site gets its own section: GCC refuses to mix the strings of inline functions (which go in COMDAT groups)
+ * with the others in a single section.
+ */
+#define LOGGER_BINARY_FORMAT_ID(msg)                                                                                   \
+    ([]() -> std::uint32_t {                                                                                           \
+        [[gnu::section(LOGGER_BINARY_FORMAT_SECTION "." LOGGER_BINARY_STRINGIFY(__COUNTER__))]] static const char     \
+          s_loggerFormat[] = msg;                                                                                      \
+        return static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(&s_loggerFormat[0]));                      \
+    }())
+
+#endif    // VENDOR_LOGGING_BINARY_FORMAT_H
@@ -0,0 +1,43 @@
+/**
+ * @file    cdc_transport.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Interface between the USB sink and the CDC class driver.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#ifndef VENDOR_LOGGING_CDC_TRANSPORT_H
+#define VENDOR_LOGGING_CDC_TRANSPORT_H
+
+#include <cstddef>
+
+namespace Logging {
+/**
+ * Queue of bytes to send over a USB CDC interface. Keeping the USB stack behind this interface lets the sink be
+ * exercised on a host with a fake backend.
+ */
+class CdcTransport {
+public:
+    virtual ~CdcTransport() = default;
+
+    /**
+     * Appends data to the transmit queue.
+     * @return False if the queue doesn't have room for all of it, in which case nothing is queued.
+     */
+    virtual bool queue(const char* data, std::size_t length) = 0;
+
+    //! Starts sending the queued data.
+    virtual void send() = 0;
+};
+}    // namespace Logging
+
+#endif    // VENDOR_LOGGING_CDC_TRANSPORT_H
@@ -0,0 +1,71 @@
+/**
+ * @file    colors.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   ANSI colors used by the text sinks.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#ifndef VENDOR_LOGGING_COLORS_H
+#define VENDOR_LOGGING_COLORS_H
+
+#include "level.h"
+
+#include <string_view>
+
+#define LOG_COLOR_BLACK  ";30"
+#define LOG_COLOR_RED    ";31"
+#define LOG_COLOR_GREEN  ";32"
+#define LOG_COLOR_BROWN  ";33"
+#define LOG_COLOR_BLUE   ";34"
+#define LOG_COLOR_PURPLE ";35"
+#define LOG_COLOR_CYAN   ";36"
+#define LOG_COLOR(COLOR) "\033[0" COLOR "m"
+#define LOG_BOLD(COLOR)  "\033[1" COLOR "m"
+#define LOG_RESET_COLOR  "\033[0m"
+#define LOG_COLOR_E      LOG_COLOR(LOG_COLOR_RED)
+#define LOG_COLOR_W      LOG_COLOR(LOG_COLOR_BROWN)
+#define LOG_COLOR_I      LOG_COLOR(LOG_COLOR_GREEN)
+#define LOG_COLOR_D      LOG_RESET_COLOR
+#define LOG_COLOR_T      LOG_COLOR(LOG_COLOR_CYAN)
+// #define LOG_BELL_E       "\a"
+#define LOG_BELL_E
+#define LOG_BELL_W
+#define LOG_BELL_I
+#define LOG_BELL_D
+#define LOG_BELL_T
+
+namespace Logging {
+inline constexpr std::string_view s_errorColor   = LOG_COLOR_E LOG_BELL_E;
+inline constexpr std::string_view s_warningColor = LOG_COLOR_W LOG_BELL_W;
+inline constexpr std::string_view s_infoColor    = LOG_COLOR_I LOG_BELL_I;
+inline constexpr std::string_view s_debugColor   = LOG_COLOR_D LOG_BELL_D;
+inline constexpr std::string_view s_traceColor   = LOG_COLOR_T LOG_BELL_T;
+
+inline constexpr std::string_view s_resetColor = LOG_RESET_COLOR;
+
+constexpr std::string_view colorStrFromLevel(Level level)
+{
+    switch (level) {
+        case Level::error: return s_errorColor;
+        case Level::warning: return s_warningColor;
+        case Level::info: return s_infoColor;
+        case Level::debug: return s_debugColor;
+        case Level::trace: return s_traceColor;
+        case Level::all:
+        case Level::none:
+        default: return "";
+    }
+}
+}    // namespace Logging
+
+#endif    // VENDOR_LOGGING_COLORS_H
@@ -0,0 +1,84 @@
+/**
+ * @file    config.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Compile-time configuration of the logging module.
+ *
+ * Every option can be overridden from the build system (e.g. `-DLOGGER_USE_BINARY_FORMAT=1`).
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef VENDOR_LOGGING_CONFIG_H
+#define VENDOR_LOGGING_CONFIG_H
+
+/**
+ * When set to 1, the LOGx macros emit binary records (format string ID, timestamp, tag and raw arguments) instead of
+ * formatting the message on the device. The records must be decoded on the host with `tools/decode_log.py`.
+ */
+#ifndef LOGGER_USE_BINARY_FORMAT
+#    define LOGGER_USE_BINARY_FORMAT 0
+#endif
+
+/**
+ * When set to 1, the LOG_BUFFER_* macros emit the raw bytes in binary blob records, rendered as hex, characters or
+ * hexdump by `tools/decode_log.py`, instead of rendering the dump on the device. The records are about 5 times smaller
+ * than the rendered text. Follows LOGGER_USE_BINARY_FORMAT by default, but can be used with text messages too: the
+ * decoder passes the text around the records through.
+ */
+#ifndef LOGGER_USE_BINARY_BUFFER_DUMPS
+#    define LOGGER_USE_BINARY_BUFFER_DUMPS LOGGER_USE_BINARY_FORMAT
+#endif
+
+/**
+ * When set to 1, the printf-style messages are formatted by the libc's vsnprintf instead of the built-in formatter of
+ * mini_printf.h. The libc one supports every conversion, but newlib's takes locks and a lot of stack.
+ */
+#ifndef LOGGER_USE_LIBC_PRINTF
+#    define LOGGER_USE_LIBC_PRINTF 0
+#endif
+
+/**
+ * Messages above this level are removed at compile time along with their format strings, whatever the level set at
+ * runtime. Their arguments are still type-checked. For example, `-DLOGGER_COMPILE_LEVEL=::Logging::Level::info`
+ * removes every LOGD and LOGT call.
+ */
+#ifndef LOGGER_COMPILE_LEVEL
+#    define LOGGER_COMPILE_LEVEL ::Logging::Level::all
+#endif
+
+/**
+ * When set to 1, MtSink numbers and timestamps every queued message and reports them to an MtSinkTracer, see
+ * MtSink::setTracer. Meant for stress tests (see tests/stress_harness.h), each queued message takes 12 more bytes.
+ */
+#ifndef LOGGER_MT_SINK_TRACING
+#    define LOGGER_MT_SINK_TRACING 0
+#endif
+
+/**
+ * When set to 1, nothing is allocated on the heap, neither at startup nor at runtime: the Logger keeps its sinks and
+ * loggers in fixed-capacity containers, and MtSink creates its task with xTaskCreateStatic. Sinks must then be created
+ * by the application (e.g. as static objects) and added with Logger::addSink(Sink&).
+ */
+#ifndef LOGGER_STATIC_CONFIG
+#    define LOGGER_STATIC_CONFIG 0
+#endif
+
+//! Maximum number of sinks of a logger, with LOGGER_STATIC_CONFIG.
+#ifndef LOGGER_MAX_SINKS
+#    define LOGGER_MAX_SINKS 4
+#endif
+
+//! Maximum number of tags with a level or sinks of their own, with LOGGER_STATIC_CONFIG.
+#ifndef LOGGER_MAX_LOGGERS
+#    define LOGGER_MAX_LOGGERS 8
+#endif
+
+#endif    // VENDOR_LOGGING_CONFIG_H
@@ -0,0 +1,135 @@
+/**
+ * @file    dma_uart_sink.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#include "dma_uart_sink.h"
+
+#include "colors.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Logging {
+bool HalUartDmaTransport::startTransmit(const char* data, std::size_t length)
+{
+    return HAL_UART_Transmit_DMA(m_uart, reinterpret_cast<const uint8_t*>(data), length) == HAL_OK;
+}
+
+DmaUartSink::DmaUartSink(UartTransport& transport) : m_transport(&transport)
+{
+    m_txDone = xSemaphoreCreateBinaryStatic(&m_txDoneBuffer);
+    configASSERT(m_txDone != nullptr);
+    m_transport->setCompletionCallback(&onTransmitComplete, this);
+}
+
+DmaUartSink::~DmaUartSink()
+{
+    // Let the last transfer complete before the buffers go away.
+    while (m_txBusy && xSemaphoreTake(m_txDone, s_maxWaitTime) == pdPASS) {}
+    m_transport->setCompletionCallback(nullptr, nullptr);
+    vSemaphoreDelete(m_txDone);
+}
+
+void DmaUartSink::onWrite(Level level, const char* string, std::size_t length)
+{
+    m_filling = true;
+    appendMessage(level, string, length);
+    endFilling();
+}
+
+void DmaUartSink::onWriteBatch(const Message* messages, std::size_t count)
+{
+    m_filling = true;
+    for (std::size_t i = 0; i < count; i++) {
+        appendMessage(messages[i].level, messages[i].string, messages[i].length);
+    }
+    endFilling();
+}
+
+void DmaUartSink::appendMessage(Level level, const char* string, std::size_t length)
+{
+    auto color = colorStrFromLevel(level);
+    append(color);
+    append({string, length});
+    if (!color.empty()) { append(s_resetColor); }
+}
+
+void DmaUartSink::append(std::string_view data)
+{
+    while (!data.empty()) {
+        if (m_fillLength == s_bufferSize) {
+            // Both buffers are full, wait for the transfer in progress to complete.
+            while (!trySend()) {
+                if (xSemaphoreTake(m_txDone, s_maxWaitTime) != pdPASS && m_txBusy) {
+                    // The transfer never completed, give up on it.
+                    m_droppedTransfers++;
+                    stats().drop(DropCause::transport);
+                    m_txBusy = false;
+                }
+            }
+        }
+
+        std::size_t chunkSize = std::min(data.size(), s_bufferSize - m_fillLength);
+        std::memcpy(&m_buffers[m_fillIndex][m_fillLength], data.data(), chunkSize);
+        m_fillLength += chunkSize;
+        data.remove_prefix(chunkSize);
+    }
+}
+
+bool DmaUartSink::trySend()
+{
+    if (m_txBusy) { return false; }
+    if (m_fillLength != 0) {
+        // Hand the buffer over before starting the transfer: it might complete, and its interrupt run trySend again,
+        // before startTransmit returns.
+        const char*       data   = &m_buffers[m_fillIndex][0];
+        const std::size_t length = m_fillLength;
+        m_fillIndex ^= 1;
+        m_fillLength = 0;
+        m_txBusy     = true;
+        if (!m_transport->startTransmit(data, length)) {
+            // The data is lost, keep filling the same buffer.
+            m_fillIndex ^= 1;
+            m_droppedTransfers++;
+            stats().drop(DropCause::transport);
+            m_txBusy = false;
+        }
+    }
+    return true;
+}
+
+void DmaUartSink::endFilling()
+{
+    // From now on, the completion interrupt sends what's left if a transfer is in progress.
+    m_filling = false;
+    trySend();
+}
+
+void DmaUartSink::onTransmitComplete(void* context)
+{
+    auto& that = *static_cast<DmaUartSink*>(context);
+
+    that.m_txBusy = false;
+    if (!that.m_filling) {
+        // The writer is done with the buffer, chain the next transfer.
+        that.trySend();
+    }
+
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    xSemaphoreGiveFromISR(that.m_txDone, &higherPriorityTaskWoken);
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+}    // namespace Logging
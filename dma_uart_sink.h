@@ -0,0 +1,115 @@
+/**
+ * @file    dma_uart_sink.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   UART sink sending its messages with a DMA.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#ifndef VENDOR_LOGGING_DMA_UART_SINK_H
+#define VENDOR_LOGGING_DMA_UART_SINK_H
+#include "mt_sink.h"
+#include "sink.h"
+#include "uart_transport.h"
+#include "usart.h"
+
+#include <FreeRTOS.h>
+#include <semphr.h>
+
+#include <atomic>
+#include <cstddef>
+#include <string_view>
+
+namespace Logging {
+/**
+ * Transport sending with HAL_UART_Transmit_DMA.
+ *
+ * onTransmitComplete must be called from HAL_UART_TxCpltCallback:
+ * @code
+ * void HAL_UART_TxCpltCallback(UART_HandleTypeDef* huart)
+ * {
+ *     if (huart == &huart2) { g_logTransport.onTransmitComplete(); }
+ * }
+ * @endcode
+ */
+class HalUartDmaTransport : public UartTransport {
+    UART_HandleTypeDef* m_uart;
+
+public:
+    explicit HalUartDmaTransport(UART_HandleTypeDef* handle) : m_uart(handle) {}
+
+    bool startTransmit(const char* data, std::size_t length) override;
+};
+
+/**
+ * Assembles the messages, colors included, in one of two buffers while the other one is being sent in the background.
+ * The writer only blocks when both buffers are full.
+ *
+ * @attention Not reentrant, wrap it in an MtSink (MtDmaUartSink) when logging from several tasks.
+ */
+class DmaUartSink : public Sink {
+private:
+    static constexpr std::size_t s_bufferSize = 256;
+    //! Maximum amount of time (in ticks) to wait for a transfer to complete before giving up on it.
+    static constexpr TickType_t s_maxWaitTime = pdMS_TO_TICKS(100);
+
+    UartTransport* m_transport;
+
+    char        m_buffers[2][s_bufferSize];
+    std::size_t m_fillIndex  = 0;    //!< Buffer being filled, the other one might be being sent.
+    std::size_t m_fillLength = 0;
+
+    //! Set while a transfer is in progress, cleared by the completion interrupt.
+    std::atomic<bool> m_txBusy = false;
+    //! Set while the writer fills the buffer, so that the completion interrupt doesn't send it from under it.
+    std::atomic<bool> m_filling = false;
+
+    SemaphoreHandle_t m_txDone = nullptr;
+    StaticSemaphore_t m_txDoneBuffer {};
+
+    std::size_t m_droppedTransfers = 0;
+
+public:
+    /**
+     * @param transport Transport to send with, must outlive the sink.
+     */
+    explicit DmaUartSink(UartTransport& transport);
+    DmaUartSink(const DmaUartSink&)            = delete;
+    DmaUartSink(DmaUartSink&&)                 = delete;
+    DmaUartSink& operator=(const DmaUartSink&) = delete;
+    DmaUartSink& operator=(DmaUartSink&&)      = delete;
+
+    ~DmaUartSink() override;
+
+    void onWrite(Level level, const char* string, std::size_t length) override;
+    void onWriteBatch(const Message* messages, std::size_t count) override;
+
+    //! Number of transfers that couldn't be started or never completed. Also counted as transport drops in the
+    //! statistics, where a drop is a whole transfer rather than a message.
+    std::size_t droppedTransfers() const { return m_droppedTransfers; }
+
+private:
+    void append(std::string_view data);
+    void appendMessage(Level level, const char* string, std::size_t length);
+    //! Sends the filled buffer if the transport is idle.
+    bool trySend();
+    //! Stops filling the buffer, sending it now if the transport is idle, or from the completion interrupt otherwise.
+    void endFilling();
+
+    static void onTransmitComplete(void* context);
+};
+
+using MtDmaUartSink = MtSink<DmaUartSink>;
+
+}    // namespace Logging
+
+#endif    // VENDOR_LOGGING_DMA_UART_SINK_H
@@ -0,0 +1,47 @@
+/**
+ * @file    dwt_clock.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#include "dwt_clock.h"
+
+#include "main.h"
+
+namespace Logging {
+void DwtClock::enable()
+{
+    CoreDebug->DEMCR = CoreDebug->DEMCR | CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL   = DWT->CTRL | DWT_CTRL_CYCCNTENA_Msk;
+}
+
+std::uint64_t DwtClock::now()
+{
+    // The extension must not be interrupted between reading the counter and updating the wrap count.
+    const std::uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    const std::uint32_t cycles = DWT->CYCCNT;
+    if (cycles < s_lastCycles) { s_wraps++; }
+    s_lastCycles                = cycles;
+    const std::uint64_t result = (static_cast<std::uint64_t>(s_wraps) << 32) | cycles;
+    __set_PRIMASK(primask);
+    return result;
+}
+
+std::uint64_t DwtClock::ticksPerSecond()
+{
+    return SystemCoreClock;
+}
+}    // namespace Logging
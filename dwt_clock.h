@@ -0,0 +1,52 @@
+/**
+ * @file    dwt_clock.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Cycle-accurate log timestamps from the DWT cycle counter.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#ifndef VENDOR_LOGGING_DWT_CLOCK_H
+#define VENDOR_LOGGING_DWT_CLOCK_H
+
+#include <cstdint>
+
+namespace Logging {
+/**
+ * 64-bit clock counting CPU cycles with the DWT cycle counter of Cortex-M3 and up.
+ *
+ * The 32-bit counter is extended in software, so now() must be called at least once per wrap of the counter (about
+ * 25 s at 168 MHz). Logging often enough does it, otherwise call it from a periodic timer.
+ *
+ * Usage:
+ * @code
+ * Logging::DwtClock::enable();
+ * Logging::Logger::setClock(&Logging::DwtClock::now, Logging::DwtClock::ticksPerSecond());
+ * @endcode
+ */
+class DwtClock {
+    inline static std::uint32_t s_lastCycles = 0;
+    inline static std::uint32_t s_wraps      = 0;
+
+public:
+    //! Starts the cycle counter.
+    static void enable();
+
+    //! Safe to call from any context.
+    static std::uint64_t now();
+
+    //! The CPU frequency, to be read again if it changes.
+    static std::uint64_t ticksPerSecond();
+};
+}    // namespace Logging
+
+#endif    // VENDOR_LOGGING_DWT_CLOCK_H
@@ -0,0 +1,61 @@
+/**
+ * @file    fatfs_file_backend.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#include "fatfs_file_backend.h"
+
+namespace Logging {
+bool FatFsFileBackend::open(const char* path)
+{
+    close();
+    m_isOpen = f_open(&m_file, path, FA_WRITE | FA_CREATE_ALWAYS) == FR_OK;
+    return m_isOpen;
+}
+
+void FatFsFileBackend::close()
+{
+    if (m_isOpen) {
+        f_close(&m_file);
+        m_isOpen = false;
+    }
+}
+
+bool FatFsFileBackend::write(const char* data, std::size_t length)
+{
+    UINT written = 0;
+    return m_isOpen && f_write(&m_file, data, length, &written) == FR_OK && written == length;
+}
+
+bool FatFsFileBackend::seek(std::size_t offset)
+{
+    return m_isOpen && f_lseek(&m_file, offset) == FR_OK;
+}
+
+bool FatFsFileBackend::sync()
+{
+    return m_isOpen && f_sync(&m_file) == FR_OK;
+}
+
+bool FatFsFileBackend::rename(const char* from, const char* to)
+{
+    return f_rename(from, to) == FR_OK;
+}
+
+void FatFsFileBackend::remove(const char* path)
+{
+    f_unlink(path);
+}
+}    // namespace Logging
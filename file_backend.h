@@ -0,0 +1,49 @@
+/**
+ * @file    file_backend.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Interface between the file sink and the filesystem.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#ifndef VENDOR_LOGGING_FILE_BACKEND_H
+#define VENDOR_LOGGING_FILE_BACKEND_H
+
+#include <cstddef>
+
+namespace Logging {
+/**
+ * Minimal filesystem used by FileSink. A backend has at most one file opened at a time.
+ */
+class FileBackend {
+public:
+    virtual ~FileBackend() = default;
+
+    //! Creates the file, or truncates it if it already exists, and opens it for writing.
+    virtual bool open(const char* path) = 0;
+    virtual void close()                = 0;
+
+    //! Writes all the data at the current position.
+    virtual bool write(const char* data, std::size_t length) = 0;
+    //! Moves the current position, from the start of the file.
+    virtual bool seek(std::size_t offset) = 0;
+    //! Commits the data written so far to the storage.
+    virtual bool sync() = 0;
+
+    //! Renames a file that is not opened. The destination must not exist.
+    virtual bool rename(const char* from, const char* to) = 0;
+    //! Deletes a file that is not opened, if it exists.
+    virtual void remove(const char* path) = 0;
+};
+}    // namespace Logging
+
+#endif    // VENDOR_LOGGING_FILE_BACKEND_H
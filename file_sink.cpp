@@ -17,6 +17,103 @@
 
 #include "file_sink.h"
 
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
 namespace Logging {
-void FileSink::onWrite(Logging::Level level, const char *string, size_t length) { }
-}  // namespace Logging
+FileSink::FileSink(FileBackend& backend, const Config& config)
+: m_backend(&backend),
+  m_path(config.path),
+  m_buffer(config.buffer),
+  m_sectorSize(config.sectorSize),
+  m_maxFileSize(config.maxFileSize),
+  m_maxFiles(std::max<std::size_t>(config.maxFiles, 1))
+{
+    assert(m_sectorSize != 0 && !m_buffer.empty() && m_buffer.size() % m_sectorSize == 0 &&
+           "The buffer must hold whole sectors");
+    rotate();
+}
+
+FileSink::~FileSink()
+{
+    flush();
+    m_backend->close();
+}
+
+void FileSink::onWrite(Level /*level*/, const char* string, std::size_t length)
+{
+    if (!m_isOpen) { return; }
+
+    while (length != 0) {
+        std::size_t chunkSize = std::min(length, m_buffer.size() - m_length);
+        std::memcpy(&m_buffer[m_length], string, chunkSize);
+        m_length += chunkSize;
+        string += chunkSize;
+        length -= chunkSize;
+
+        if (m_length == m_buffer.size()) { writeSectors(m_length); }
+    }
+}
+
+void FileSink::flush()
+{
+    if (!m_isOpen) { return; }
+
+    writeSectors(m_length - (m_length % m_sectorSize));
+    if (m_length != 0) {
+        // Write the partial sector, but keep it: it will be written again, whole, once it is full.
+        if (!m_backend->write(&m_buffer[0], m_length) || !m_backend->seek(m_fileOffset)) { m_writeErrors++; }
+    }
+    if (!m_backend->sync()) { m_writeErrors++; }
+}
+
+void FileSink::writeSectors(std::size_t length)
+{
+    if (length == 0) { return; }
+
+    if (m_backend->write(&m_buffer[0], length)) { m_fileOffset += length; }
+    else {
+        m_writeErrors++;
+        stats().drop(DropCause::transport);
+        // Whatever got written will be overwritten.
+        m_backend->seek(m_fileOffset);
+    }
+    m_length -= length;
+    std::memmove(&m_buffer[0], &m_buffer[length], m_length);
+
+    if (m_maxFileSize != 0 && m_fileOffset >= m_maxFileSize) {
+        // The partial sector left in the buffer goes to the new file.
+        m_backend->sync();
+        rotate();
+    }
+}
+
+void FileSink::rotate()
+{
+    m_backend->close();
+
+    char from[s_maxPathLength];
+    char to[s_maxPathLength];
+    makePath(to, m_maxFiles - 1);
+    m_backend->remove(to);
+    for (std::size_t i = m_maxFiles - 1; i > 0; i--) {
+        makePath(from, i - 1);
+        m_backend->rename(from, to);
+        std::memcpy(&to[0], &from[0], sizeof(to));
+    }
+
+    m_isOpen     = m_backend->open(m_path);
+    m_fileOffset = 0;
+    if (!m_isOpen) { m_writeErrors++; }
+}
+
+void FileSink::makePath(char (&path)[s_maxPathLength], std::size_t index) const
+{
+    if (index == 0) { std::snprintf(&path[0], sizeof(path), "%s", m_path); }
+    else {
+        std::snprintf(&path[0], sizeof(path), "%s.%u", m_path, static_cast<unsigned int>(index));
+    }
+}
+}    // namespace Logging
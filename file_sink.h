@@ -14,17 +14,84 @@
  * You should have received a copy of the GNU General Public License along with this program. If
  * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
  */
-#ifndef DOORSTOPPER_SRC_CEP_SERVICES_LOGGING_FILE_SINK_H
-#define DOORSTOPPER_SRC_CEP_SERVICES_LOGGING_FILE_SINK_H
+#ifndef VENDOR_LOGGING_FILE_SINK_H
+#define VENDOR_LOGGING_FILE_SINK_H
 
+#include "file_backend.h"
+#include "mt_sink.h"
 #include "sink.h"
-namespace Logging {
 
+#include <cstddef>
+#include <span>
+
+namespace Logging {
+/**
+ * Writes the messages to a file, in whole sectors.
+ *
+ * The messages are gathered in a caller-provided buffer, which is written once full. Since the file always starts on a
+ * sector boundary and the buffer holds whole sectors, every write is aligned. flush() also writes the partial last
+ * sector, then seeks back to its start: the next write rewrites it whole.
+ *
+ * A new file is started every time the sink is created, the previous ones being kept as `path.1`, `path.2`, etc. The
+ * same rotation happens once the file reaches maxFileSize.
+ *
+ * @attention Writing to the file blocks, wrap the sink in an MtSink (MtFileSink) to write from a background task.
+ */
 class FileSink : public Sink {
- public:
-  void onWrite(Level level, const char* string, size_t length) final;
+public:
+    static constexpr std::size_t s_maxPathLength = 64;
+
+    struct Config {
+        const char*     path;
+        std::span<char> buffer;               //!< Its size must be a multiple of sectorSize.
+        std::size_t     sectorSize  = 512;    //!< 512 for SD cards, usually 4096 for flash.
+        std::size_t     maxFileSize = 0;      //!< Size at which the file is rotated, 0 to never rotate.
+        std::size_t     maxFiles    = 4;      //!< Number of files kept, the current one included.
+    };
+
+private:
+    FileBackend*    m_backend;
+    const char*     m_path;
+    std::span<char> m_buffer;
+    std::size_t     m_sectorSize;
+    std::size_t     m_maxFileSize;
+    std::size_t     m_maxFiles;
+
+    std::size_t m_length      = 0;    //!< Bytes in the buffer.
+    std::size_t m_fileOffset  = 0;    //!< Offset of the buffer in the file, always on a sector boundary.
+    bool        m_isOpen      = false;
+    std::size_t m_writeErrors = 0;
+
+public:
+    /**
+     * @param backend Filesystem to write to, must outlive the sink.
+     * @param config
+     */
+    FileSink(FileBackend& backend, const Config& config);
+    FileSink(const FileSink&)            = delete;
+    FileSink(FileSink&&)                 = delete;
+    FileSink& operator=(const FileSink&) = delete;
+    FileSink& operator=(FileSink&&)      = delete;
+
+    ~FileSink() override;
+
+    void onWrite(Level level, const char* string, std::size_t length) override;
+    //! Writes everything to the file and commits it to the storage.
+    void flush() override;
+
+    //! Number of writes that failed, their data is lost. The failed writes of whole sectors are also counted as
+    //! transport drops in the statistics.
+    std::size_t writeErrors() const { return m_writeErrors; }
+
+private:
+    //! Writes the first sectors of the buffer, then keeps what's left.
+    void writeSectors(std::size_t length);
+    void rotate();
+    void makePath(char (&path)[s_maxPathLength], std::size_t index) const;
 };
 
-}  // namespace Logging
+using MtFileSink = MtSink<FileSink>;
+
+}    // namespace Logging
 
-#endif  // DOORSTOPPER_SRC_CEP_SERVICES_LOGGING_FILE_SINK_H
+#endif    // VENDOR_LOGGING_FILE_SINK_H
@@ -0,0 +1,527 @@
+/**
+ * @file    format.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Compile-time checked, std::format-style formatter.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#ifndef VENDOR_LOGGING_FORMAT_H
+#define VENDOR_LOGGING_FORMAT_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Subset of std::format, parsed at compile time so that each call site gets its own formatter, with no allocation and
+ * no runtime parsing.
+ *
+ * Replacement fields are `{}` or `{:spec}`, with `spec` being `[[fill]align][sign][#][0][width][.precision][type]`:
+ *  - align: `<`, `>` or `^`,
+ *  - sign: `+`, `-` or ` `,
+ *  - type: `b`, `o`, `d`, `x`, `X`, `c` for integers, `f`, `F`, `e`, `E` for floating points (default `f`, up to 9
+ *    decimals), `s` for strings and booleans, `p` for pointers.
+ *
+ * Arguments can only be referred to in order, `{0}` is not supported. `{{` and `}}` are literal braces.
+ */
+namespace Logging::Format {
+template<std::size_t N>
+struct FixedString {
+    char data[N] = {};
+
+    consteval FixedString(const char (&str)[N]) { std::copy_n(&str[0], N, &data[0]); }
+
+    constexpr std::string_view view() const { return {&data[0], N - 1}; }
+};
+
+struct Spec {
+    char        fill      = ' ';
+    char        align     = '\0';    //!< '<', '>', '^', or '\0' for the default of the type.
+    char        sign      = '-';
+    bool        alternate = false;
+    bool        zeroPad   = false;
+    std::size_t width     = 0;
+    int         precision = -1;
+    char        type      = '\0';
+};
+
+struct Segment {
+    bool        isField  = false;
+    std::size_t begin    = 0;    //!< Position of a literal in the format string.
+    std::size_t length   = 0;
+    std::size_t argIndex = 0;
+    Spec        spec     = {};
+};
+
+// Deliberately not constexpr: calling it while parsing stops the compilation, the reason showing in the diagnostic.
+void invalidFormatString(const char* reason);
+
+namespace Detail {
+consteval bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+consteval std::size_t parseNumber(std::string_view spec, std::size_t& i)
+{
+    std::size_t value = 0;
+    while (i < spec.size() && isDigit(spec[i])) {
+        value = value * 10 + static_cast<std::size_t>(spec[i++] - '0');
+    }
+    return value;
+}
+
+consteval Spec parseSpec(std::string_view spec)
+{
+    Spec        result;
+    std::size_t i       = 0;
+    auto        isAlign = [](char c) { return c == '<' || c == '>' || c == '^'; };
+    if (spec.size() >= 2 && isAlign(spec[1])) {
+        result.fill  = spec[0];
+        result.align = spec[1];
+        i            = 2;
+    }
+    else if (!spec.empty() && isAlign(spec[0])) {
+        result.align = spec[0];
+        i            = 1;
+    }
+    if (i < spec.size() && (spec[i] == '+' || spec[i] == '-' || spec[i] == ' ')) { result.sign = spec[i++]; }
+    if (i < spec.size() && spec[i] == '#') {
+        result.alternate = true;
+        i++;
+    }
+    if (i < spec.size() && spec[i] == '0') {
+        result.zeroPad = true;
+        i++;
+    }
+    result.width = parseNumber(spec, i);
+    if (i < spec.size() && spec[i] == '.') {
+        i++;
+        if (i == spec.size() || !isDigit(spec[i])) { invalidFormatString("missing precision after '.'"); }
+        result.precision = static_cast<int>(parseNumber(spec, i));
+    }
+    if (i < spec.size()) {
+        if (std::string_view {"bodxXcfFeEsp"}.find(spec[i]) == std::string_view::npos) {
+            invalidFormatString("unknown presentation type");
+        }
+        result.type = spec[i++];
+    }
+    if (i != spec.size()) { invalidFormatString("invalid format specification"); }
+    return result;
+}
+
+/**
+ * Splits the format string in literals and replacement fields.
+ * @return The number of replacement fields.
+ */
+template<typename OnSegment>
+consteval std::size_t parse(std::string_view fmt, OnSegment&& onSegment)
+{
+    std::size_t fields       = 0;
+    std::size_t literalBegin = 0;
+    auto        endLiteral   = [&](std::size_t end) {
+        if (end > literalBegin) { onSegment(Segment {.begin = literalBegin, .length = end - literalBegin}); }
+    };
+
+    for (std::size_t i = 0; i < fmt.size(); i++) {
+        if (fmt[i] == '}') {
+            if (i + 1 == fmt.size() || fmt[i + 1] != '}') { invalidFormatString("unmatched '}'"); }
+            // Keep one of the two braces.
+            endLiteral(i + 1);
+            literalBegin = ++i + 1;
+        }
+        else if (fmt[i] == '{') {
+            if (i + 1 < fmt.size() && fmt[i + 1] == '{') {
+                endLiteral(i + 1);
+                literalBegin = ++i + 1;
+                continue;
+            }
+            endLiteral(i);
+            std::size_t end = fmt.find('}', i);
+            if (end == std::string_view::npos) { invalidFormatString("unmatched '{'"); }
+            std::string_view field = fmt.substr(i + 1, end - i - 1);
+            if (!field.empty() && field[0] != ':') { invalidFormatString("only automatic argument indexing is supported"); }
+            onSegment(Segment {
+              .isField  = true,
+              .argIndex = fields++,
+              .spec     = parseSpec(field.empty() ? field : field.substr(1)),
+            });
+            i            = end;
+            literalBegin = end + 1;
+        }
+    }
+    endLiteral(fmt.size());
+    return fields;
+}
+
+template<FixedString Fmt>
+struct Parsed {
+    static constexpr std::size_t s_segmentCount = []() consteval {
+        std::size_t count = 0;
+        parse(Fmt.view(), [&](const Segment&) { count++; });
+        return count;
+    }();
+    static constexpr std::size_t s_fieldCount = parse(Fmt.view(), [](const Segment&) {});
+    static constexpr auto        s_segments   = []() consteval {
+        std::array<Segment, s_segmentCount> segments {};
+        std::size_t                         i = 0;
+        parse(Fmt.view(), [&](const Segment& segment) { segments[i++] = segment; });
+        return segments;
+    }();
+};
+
+template<typename T>
+consteval void checkSpec(const Spec& spec)
+{
+    using U                = std::remove_cvref_t<T>;
+    const std::string_view types = [] {
+        if constexpr (std::is_same_v<U, bool>) { return "sbodxX"; }
+        else if constexpr (std::is_same_v<U, char>) {
+            return "cbodxX";
+        }
+        else if constexpr (std::is_integral_v<U> || std::is_enum_v<U>) {
+            return "bodxXc";
+        }
+        else if constexpr (std::is_floating_point_v<U>) {
+            return "fFeE";
+        }
+        else if constexpr (std::is_convertible_v<const U&, std::string_view> ||
+                           std::is_convertible_v<const U&, const char*>) {
+            return "s";
+        }
+        else if constexpr (std::is_pointer_v<U> || std::is_null_pointer_v<U>) {
+            return "p";
+        }
+        else {
+            static_assert(sizeof(U) == 0, "Unsupported argument type");
+            return "";
+        }
+    }();
+    if (spec.type != '\0' && types.find(spec.type) == std::string_view::npos) {
+        invalidFormatString("presentation type not supported by the argument's type");
+    }
+}
+
+template<FixedString Fmt, typename... Args>
+consteval bool checkArgs()
+{
+    using P    = Parsed<Fmt>;
+    using Tuple = std::tuple<Args...>;
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        (
+          [&] {
+              constexpr Segment segment = P::s_segments[I];
+              if constexpr (segment.isField) {
+                  checkSpec<std::tuple_element_t<segment.argIndex, Tuple>>(segment.spec);
+              }
+          }(),
+          ...);
+    }(std::make_index_sequence<P::s_segmentCount> {});
+    return true;
+}
+
+/**
+ * Bounded output, counting what didn't fit like snprintf does.
+ */
+class Writer {
+    char*       m_buffer;
+    std::size_t m_size;
+    std::size_t m_length = 0;
+
+public:
+    Writer(char* buffer, std::size_t size) : m_buffer(buffer), m_size(size) {}
+
+    //! Length of the whole output, even the part that didn't fit.
+    std::size_t length() const { return m_length; }
+
+    void put(char c)
+    {
+        if (m_length < m_size) { m_buffer[m_length] = c; }
+        m_length++;
+    }
+
+    void write(const char* data, std::size_t length)
+    {
+        if (m_length < m_size) { std::memcpy(&m_buffer[m_length], data, std::min(length, m_size - m_length)); }
+        m_length += length;
+    }
+
+    void fill(char c, std::size_t count)
+    {
+        if (m_length < m_size) { std::memset(&m_buffer[m_length], c, std::min(count, m_size - m_length)); }
+        m_length += count;
+    }
+};
+
+/**
+ * Writes a value, padded to the width of the field.
+ * @param prefix Length of the sign and base prefix, the zeros of zero-padding go after them.
+ */
+inline void writePadded(
+  Writer& out, const Spec& spec, char defaultAlign, const char* content, std::size_t length, std::size_t prefix = 0)
+{
+    if (spec.width <= length) {
+        out.write(content, length);
+        return;
+    }
+    const std::size_t padding = spec.width - length;
+    if (spec.zeroPad && spec.align == '\0') {
+        out.write(content, prefix);
+        out.fill('0', padding);
+        out.write(content + prefix, length - prefix);
+        return;
+    }
+    switch (spec.align == '\0' ? defaultAlign : spec.align) {
+        case '<':
+            out.write(content, length);
+            out.fill(spec.fill, padding);
+            break;
+        case '^':
+            out.fill(spec.fill, padding / 2);
+            out.write(content, length);
+            out.fill(spec.fill, padding - padding / 2);
+            break;
+        default:
+            out.fill(spec.fill, padding);
+            out.write(content, length);
+            break;
+    }
+}
+
+//! Writes the digits of a value backward, ending at `end`. @return The number of digits.
+template<typename U>
+std::size_t writeDigits(char* end, U value, unsigned base, bool upper)
+{
+    const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char*       it     = end;
+    do {
+        *--it = digits[value % base];
+        value /= base;
+    } while (value != 0);
+    return static_cast<std::size_t>(end - it);
+}
+
+template<typename T>
+void formatInteger(Writer& out, const Spec& spec, T value)
+{
+    using U = std::make_unsigned_t<T>;
+    if (spec.type == 'c') {
+        const char c = static_cast<char>(value);
+        writePadded(out, spec, '<', &c, 1);
+        return;
+    }
+
+    unsigned    base   = 10;
+    const char* prefix = "";
+    switch (spec.type) {
+        case 'b': base = 2, prefix = "0b"; break;
+        case 'o': base = 8, prefix = "0"; break;
+        case 'x': base = 16, prefix = "0x"; break;
+        case 'X': base = 16, prefix = "0X"; break;
+        default: break;
+    }
+
+    const bool negative  = value < 0;
+    const U    magnitude = negative ? static_cast<U>(U(0) - static_cast<U>(value)) : static_cast<U>(value);
+
+    // Sign, prefix and the digits of a 64-bit value in binary.
+    char        buffer[2 + 2 + 64];
+    char*       end    = &buffer[sizeof(buffer)];
+    std::size_t digits = writeDigits(end, magnitude, base, spec.type == 'X');
+    char*       begin  = end - digits;
+    if (spec.alternate && base != 10 && !(base == 8 && magnitude == 0)) {
+        const std::size_t prefixLength = std::strlen(prefix);
+        begin -= prefixLength;
+        std::memcpy(begin, prefix, prefixLength);
+    }
+    if (negative) { *--begin = '-'; }
+    else if (spec.sign != '-') {
+        *--begin = spec.sign;
+    }
+    writePadded(out, spec, '>', begin, static_cast<std::size_t>(end - begin), static_cast<std::size_t>(end - begin) - digits);
+}
+
+inline void formatFloat(Writer& out, const Spec& spec, double value)
+{
+    static constexpr int           s_maxPrecision = 9;
+    static constexpr std::uint64_t s_powers[]     = {
+      1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+    char        buffer[48];
+    std::size_t length = 0;
+
+    if (std::signbit(value)) {
+        buffer[length++] = '-';
+        value            = -value;
+    }
+    else if (spec.sign != '-') {
+        buffer[length++] = spec.sign;
+    }
+    const std::size_t sign  = length;
+    const bool        upper = spec.type == 'F' || spec.type == 'E';
+
+    if (value != value || value == std::numeric_limits<double>::infinity()) {
+        std::memcpy(&buffer[length], value != value ? (upper ? "NAN" : "nan") : (upper ? "INF" : "inf"), 3);
+        writePadded(out, spec, '>', &buffer[0], length + 3);
+        return;
+    }
+
+    const int precision  = std::min(spec.precision < 0 ? 6 : spec.precision, s_maxPrecision);
+    bool      scientific = spec.type == 'e' || spec.type == 'E' || value >= 1e19;
+    int       exponent   = 0;
+    if (scientific && value != 0) {
+        while (value >= 10) {
+            value /= 10;
+            exponent++;
+        }
+        while (value < 1) {
+            value *= 10;
+            exponent--;
+        }
+    }
+
+    auto integral   = static_cast<std::uint64_t>(value);
+    const double scaled     = (value - static_cast<double>(integral)) * static_cast<double>(s_powers[precision]);
+    auto         fractional = static_cast<std::uint64_t>(scaled);
+    // Ties go to the even digit, like the libc's printf: 0.5 is printed as 0 and 1.5 as 2.
+    const double remainder = scaled - static_cast<double>(fractional);
+    const auto   last      = precision != 0 ? fractional : integral;
+    if (remainder > 0.5 || (remainder == 0.5 && (last & 1) != 0)) { fractional++; }
+    if (fractional >= s_powers[precision]) {
+        // Rounded up to the next integer.
+        fractional -= s_powers[precision];
+        integral++;
+        if (scientific && integral == 10) {
+            integral = 1;
+            exponent++;
+        }
+    }
+
+    char* end = &buffer[length + 20];
+    length += writeDigits(end, integral, 10, false);
+    std::memmove(&buffer[sign], end - (length - sign), length - sign);
+    if (precision != 0 || spec.alternate) { buffer[length++] = '.'; }
+    if (precision != 0) {
+        char* fractionEnd = &buffer[length + precision];
+        std::size_t written = writeDigits(fractionEnd, fractional, 10, false);
+        std::memset(&buffer[length], '0', precision - written);
+        length += precision;
+    }
+    if (scientific) {
+        buffer[length++] = upper ? 'E' : 'e';
+        buffer[length++] = exponent < 0 ? '-' : '+';
+        const unsigned magnitude = static_cast<unsigned>(exponent < 0 ? -exponent : exponent);
+        if (magnitude < 10) { buffer[length++] = '0'; }
+        char* exponentEnd = &buffer[length + (magnitude < 10 ? 1 : magnitude < 100 ? 2 : 3)];
+        length += writeDigits(exponentEnd, magnitude, 10, false);
+    }
+    writePadded(out, spec, '>', &buffer[0], length, sign);
+}
+
+inline void formatString(Writer& out, const Spec& spec, std::string_view str)
+{
+    if (spec.precision >= 0) { str = str.substr(0, static_cast<std::size_t>(spec.precision)); }
+    writePadded(out, spec, '<', str.data(), str.size());
+}
+
+template<typename T>
+void formatArg(Writer& out, const Spec& spec, const T& value)
+{
+    using U = std::remove_cvref_t<T>;
+    if constexpr (std::is_same_v<U, bool>) {
+        if (spec.type == '\0' || spec.type == 's') { formatString(out, spec, value ? "true" : "false"); }
+        else {
+            formatInteger(out, spec, static_cast<unsigned int>(value));
+        }
+    }
+    else if constexpr (std::is_same_v<U, char>) {
+        if (spec.type == '\0' || spec.type == 'c') { writePadded(out, spec, '<', &value, 1); }
+        else {
+            formatInteger(out, spec, static_cast<unsigned char>(value));
+        }
+    }
+    else if constexpr (std::is_enum_v<U>) {
+        formatInteger(out, spec, static_cast<std::underlying_type_t<U>>(value));
+    }
+    else if constexpr (std::is_integral_v<U>) {
+        formatInteger(out, spec, value);
+    }
+    else if constexpr (std::is_floating_point_v<U>) {
+        formatFloat(out, spec, static_cast<double>(value));
+    }
+    else if constexpr (std::is_convertible_v<const U&, const char*>) {
+        const char* str = value;
+        formatString(out, spec, str != nullptr ? std::string_view {str} : std::string_view {"(null)"});
+    }
+    else if constexpr (std::is_convertible_v<const U&, std::string_view>) {
+        formatString(out, spec, value);
+    }
+    else {
+        Spec hex      = spec;
+        hex.type      = 'x';
+        hex.alternate = true;
+        formatInteger(out, hex, reinterpret_cast<std::uintptr_t>(value));
+    }
+}
+
+template<FixedString Fmt, std::size_t I, typename Tuple>
+void writeSegment(Writer& out, const Tuple& args)
+{
+    constexpr Segment segment = Parsed<Fmt>::s_segments[I];
+    if constexpr (segment.isField) { formatArg(out, segment.spec, std::get<segment.argIndex>(args)); }
+    else {
+        out.write(&Fmt.data[segment.begin], segment.length);
+    }
+}
+}    // namespace Detail
+
+/**
+ * Checks the arguments against the format string, at compile time.
+ */
+template<FixedString Fmt, typename... Args>
+constexpr void check(const Args&... /*args*/)
+{
+    static_assert(Detail::Parsed<Fmt>::s_fieldCount == sizeof...(Args),
+                  "The number of arguments doesn't match the format string");
+    if constexpr (Detail::Parsed<Fmt>::s_fieldCount == sizeof...(Args)) {
+        static_assert(Detail::checkArgs<Fmt, std::remove_cvref_t<Args>...>());
+    }
+}
+
+/**
+ * Formats the arguments in a buffer, without null terminator.
+ * @return The length of the whole output, which was truncated if it is greater than `size`.
+ */
+template<FixedString Fmt, typename... Args>
+std::size_t formatTo(char* buffer, std::size_t size, const Args&... args)
+{
+    check<Fmt>(args...);
+
+    Detail::Writer out {buffer, size};
+    const auto     argTuple = std::tie(args...);
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        (Detail::writeSegment<Fmt, I>(out, argTuple), ...);
+    }(std::make_index_sequence<Detail::Parsed<Fmt>::s_segmentCount> {});
+    return out.length();
+}
+}    // namespace Logging::Format
+
+#endif    // VENDOR_LOGGING_FORMAT_H
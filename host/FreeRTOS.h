@@ -0,0 +1,104 @@
+/**
+ * @file    FreeRTOS.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Host stand-in for the FreeRTOS kernel, see "Host build" in README.md.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#ifndef VENDOR_LOGGING_HOST_FREERTOS_H
+#define VENDOR_LOGGING_HOST_FREERTOS_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+using BaseType_t  = long;
+using UBaseType_t = unsigned long;
+using TickType_t  = std::uint32_t;
+using StackType_t = std::uintptr_t;
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE  ((BaseType_t)1)
+#define pdFAIL  pdFALSE
+#define pdPASS  pdTRUE
+
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFUL)
+
+#define configTICK_RATE_HZ              ((TickType_t)1000)
+#define configMAX_PRIORITIES            7
+#define configMINIMAL_STACK_SIZE        128
+#define configSTACK_DEPTH_TYPE          std::uint16_t
+#define configSUPPORT_STATIC_ALLOCATION 1
+#define configSUPPORT_DYNAMIC_ALLOCATION 1
+#define INCLUDE_vTaskDelete             1
+
+#define configASSERT(x) assert(x)
+
+#define pdMS_TO_TICKS(xTimeInMs) ((TickType_t)(((TickType_t)(xTimeInMs) * configTICK_RATE_HZ) / (TickType_t)1000U))
+
+namespace Logging::Host {
+/**
+ * Exception number of the interrupt the calling thread simulates, 0 outside of InterruptScope. Stands in for the ICSR
+ * register read by Port::isInIsr.
+ */
+std::uint32_t activeInterrupt();
+
+//! Priority of the interrupt the calling thread simulates. Stands in for the NVIC register read by
+//! Port::interruptPriority.
+std::uint8_t interruptPriority();
+
+/**
+ * Makes the calling thread act as an interrupt handler until destroyed: Port::isInIsr returns true, so the logger takes
+ * its FromISR paths. Used to interleave "interrupts" with tasks in the stress tests.
+ */
+class InterruptScope {
+public:
+    explicit InterruptScope(std::uint32_t exceptionNumber = 16, std::uint8_t priority = 0);
+    InterruptScope(const InterruptScope&)            = delete;
+    InterruptScope& operator=(const InterruptScope&) = delete;
+    ~InterruptScope();
+
+private:
+    std::uint32_t m_previous;
+    std::uint8_t  m_previousPriority;
+};
+
+//! Number of successful pvPortMalloc calls so far.
+std::size_t heapAllocations();
+}    // namespace Logging::Host
+
+#define portNVIC_INT_CTRL_REG          (::Logging::Host::activeInterrupt())
+#define LOGGER_HOST_INTERRUPT_PRIORITY (::Logging::Host::interruptPriority())
+
+#define portYIELD()                          ::Logging::Host::yield()
+#define portYIELD_FROM_ISR(xSwitchRequired) ((void)(xSwitchRequired))
+#define portEND_SWITCHING_ISR(xSwitchRequired) portYIELD_FROM_ISR(xSwitchRequired)
+
+namespace Logging::Host {
+void yield();
+}    // namespace Logging::Host
+
+void* pvPortMalloc(std::size_t size);
+void  vPortFree(void* pointer);
+
+//! Storage of a task created with xTaskCreateStatic, big enough for the host's thread bookkeeping.
+struct StaticTask_t {
+    alignas(std::max_align_t) unsigned char storage[256];
+};
+
+//! Storage of a semaphore created with one of the xSemaphoreCreate*Static functions.
+struct StaticSemaphore_t {
+    alignas(std::max_align_t) unsigned char storage[128];
+};
+
+#endif    // VENDOR_LOGGING_HOST_FREERTOS_H
@@ -0,0 +1,448 @@
+/**
+ * @file    freertos_host.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   FreeRTOS tasks and semaphores on top of POSIX threads.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "task.h"
+
+#include <pthread.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <thread>
+
+namespace Logging::Host {
+namespace {
+//! Thrown by the blocking calls of a deleted task, to unwind its thread.
+struct TaskExit {};
+
+thread_local std::uint32_t t_activeInterrupt   = 0;
+thread_local std::uint8_t  t_interruptPriority = 0;
+
+std::atomic<std::size_t> s_heapAllocations = 0;
+
+const auto s_start = std::chrono::steady_clock::now();
+
+template<typename Predicate>
+bool waitFor(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, TickType_t ticks, Predicate predicate)
+{
+    if (ticks == portMAX_DELAY) {
+        cv.wait(lock, predicate);
+        return true;
+    }
+    return cv.wait_for(lock, std::chrono::milliseconds(ticks), predicate);
+}
+}    // namespace
+
+struct Task {
+    std::mutex              mutex;
+    std::condition_variable changed;
+
+    TaskFunction_t function   = nullptr;
+    void*          parameters = nullptr;
+    UBaseType_t    priority   = 0;
+    bool           isStatic   = false;
+    bool           isCreated  = false;    //!< False for the threads adopted by current().
+
+    std::uint32_t notifyValue = 0;
+    bool          deleted     = false;    //!< Set by vTaskDelete, the task must stop.
+    bool          exited      = false;    //!< Set once the thread is done with the task.
+    bool          selfDeleted = false;    //!< Deleted by itself, freed later like FreeRTOS's idle task would.
+    Task*         nextTerminated = nullptr;
+
+    //! Throws TaskExit if the task was deleted. `mutex` must be held.
+    void checkDeleted() const
+    {
+        if (deleted && isCreated) { throw TaskExit {}; }
+    }
+};
+
+static_assert(sizeof(Task) <= sizeof(StaticTask_t) && alignof(Task) <= alignof(StaticTask_t));
+
+namespace {
+thread_local Task* t_current = nullptr;
+
+/**
+ * The tasks that deleted themselves. Like FreeRTOS, which leaves them to the idle task, they aren't freed right away:
+ * whoever is waiting for them to stop might still be using their handle (e.g. MtSink's destructor).
+ */
+class Graveyard {
+public:
+    ~Graveyard()
+    {
+        std::scoped_lock lock(m_lock);
+        while (m_tasks != nullptr) {
+            Task* task = m_tasks;
+            m_tasks    = task->nextTerminated;
+            task->~Task();
+            vPortFree(task);
+        }
+    }
+
+    void bury(Task* task)
+    {
+        std::scoped_lock lock(m_lock);
+        task->nextTerminated = m_tasks;
+        m_tasks              = task;
+    }
+
+private:
+    std::mutex m_lock;
+    Task*      m_tasks = nullptr;
+};
+
+Graveyard s_graveyard;
+
+Task& current()
+{
+    if (t_current == nullptr) {
+        // A thread that wasn't created by xTaskCreate, e.g. main() or a std::thread of a test.
+        thread_local Task adopted;
+        t_current = &adopted;
+    }
+    return *t_current;
+}
+
+void* run(void* arg)
+{
+    auto* task = static_cast<Task*>(arg);
+    t_current  = task;
+    try {
+        task->function(task->parameters);
+    }
+    catch (const TaskExit&) {
+    }
+
+    bool bury = false;
+    {
+        std::scoped_lock lock(task->mutex);
+        task->exited = true;
+        bury         = task->selfDeleted && !task->isStatic;
+        task->changed.notify_all();
+    }
+    // Whoever deleted us might destroy the task as soon as the lock is released.
+    if (bury) { s_graveyard.bury(task); }
+    return nullptr;
+}
+
+bool start(Task* task, TaskFunction_t function, void* parameters, UBaseType_t priority)
+{
+    task->function   = function;
+    task->parameters = parameters;
+    task->priority   = priority;
+    task->isCreated  = true;
+
+    pthread_attr_t attributes;
+    pthread_attr_init(&attributes);
+    pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+    pthread_t  thread;
+    const bool started = pthread_create(&thread, &attributes, &run, task) == 0;
+    pthread_attr_destroy(&attributes);
+    return started;
+}
+}    // namespace
+
+std::uint32_t activeInterrupt()
+{
+    return t_activeInterrupt;
+}
+
+std::uint8_t interruptPriority()
+{
+    return t_interruptPriority;
+}
+
+InterruptScope::InterruptScope(std::uint32_t exceptionNumber, std::uint8_t priority)
+: m_previous(t_activeInterrupt), m_previousPriority(t_interruptPriority)
+{
+    t_activeInterrupt   = exceptionNumber;
+    t_interruptPriority = priority;
+}
+
+InterruptScope::~InterruptScope()
+{
+    t_activeInterrupt   = m_previous;
+    t_interruptPriority = m_previousPriority;
+}
+
+std::size_t heapAllocations()
+{
+    return s_heapAllocations.load(std::memory_order_relaxed);
+}
+
+void yield()
+{
+    std::this_thread::yield();
+}
+
+struct Semaphore {
+    std::mutex              mutex;
+    std::condition_variable changed;
+    unsigned int            count    = 0;
+    bool                    isStatic = false;
+};
+
+static_assert(sizeof(Semaphore) <= sizeof(StaticSemaphore_t) && alignof(Semaphore) <= alignof(StaticSemaphore_t));
+}    // namespace Logging::Host
+
+using Logging::Host::Semaphore;
+using Logging::Host::Task;
+
+void* pvPortMalloc(std::size_t size)
+{
+    void* pointer = std::malloc(size);
+    if (pointer != nullptr) { Logging::Host::s_heapAllocations.fetch_add(1, std::memory_order_relaxed); }
+    return pointer;
+}
+
+void vPortFree(void* pointer)
+{
+    std::free(pointer);
+}
+
+BaseType_t xTaskCreate(TaskFunction_t         function,
+                       const char* /*name*/,
+                       configSTACK_DEPTH_TYPE /*stackDepth*/,
+                       void*                  parameters,
+                       UBaseType_t            priority,
+                       TaskHandle_t*          createdTask)
+{
+    void* storage = pvPortMalloc(sizeof(Task));
+    if (storage == nullptr) { return pdFAIL; }
+    auto* task = new (storage) Task;
+    if (createdTask != nullptr) { *createdTask = task; }
+    if (!Logging::Host::start(task, function, parameters, priority)) {
+        task->~Task();
+        vPortFree(storage);
+        if (createdTask != nullptr) { *createdTask = nullptr; }
+        return pdFAIL;
+    }
+    return pdPASS;
+}
+
+TaskHandle_t xTaskCreateStatic(TaskFunction_t function,
+                               const char* /*name*/,
+                               std::uint32_t /*stackDepth*/,
+                               void*         parameters,
+                               UBaseType_t   priority,
+                               StackType_t* /*stack*/,
+                               StaticTask_t* taskBuffer)
+{
+    auto* task     = new (&taskBuffer->storage[0]) Task;
+    task->isStatic = true;
+    if (!Logging::Host::start(task, function, parameters, priority)) {
+        task->~Task();
+        return nullptr;
+    }
+    return task;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    Task& self = Logging::Host::current();
+    if (task == nullptr || task == &self) {
+        configASSERT(self.isCreated && "Only the tasks created by xTaskCreate can be deleted");
+        {
+            std::scoped_lock lock(self.mutex);
+            self.deleted     = true;
+            self.selfDeleted = true;
+        }
+        throw Logging::Host::TaskExit {};
+    }
+
+    std::unique_lock lock(task->mutex);
+    task->deleted = true;
+    task->changed.notify_all();
+    task->changed.wait(lock, [task] { return task->exited; });
+    lock.unlock();
+    if (task->isStatic) { task->~Task(); }
+    else {
+        task->~Task();
+        vPortFree(task);
+    }
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle()
+{
+    return &Logging::Host::current();
+}
+
+void vTaskPrioritySet(TaskHandle_t task, UBaseType_t priority)
+{
+    Task& target = task == nullptr ? Logging::Host::current() : *task;
+    std::scoped_lock lock(target.mutex);
+    target.priority = priority;
+}
+
+UBaseType_t uxTaskPriorityGet(TaskHandle_t task)
+{
+    Task& target = task == nullptr ? Logging::Host::current() : *task;
+    std::scoped_lock lock(target.mutex);
+    return target.priority;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    Task&            self = Logging::Host::current();
+    std::unique_lock lock(self.mutex);
+    if (ticks == 0) {
+        lock.unlock();
+        std::this_thread::yield();
+        lock.lock();
+    }
+    else {
+        Logging::Host::waitFor(self.changed, lock, ticks, [&self] { return self.deleted; });
+    }
+    self.checkDeleted();
+}
+
+TickType_t xTaskGetTickCount()
+{
+    const auto elapsed = std::chrono::steady_clock::now() - Logging::Host::s_start;
+    return static_cast<TickType_t>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+}
+
+TickType_t xTaskGetTickCountFromISR()
+{
+    return xTaskGetTickCount();
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    std::scoped_lock lock(task->mutex);
+    task->notifyValue++;
+    task->changed.notify_all();
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higherPriorityTaskWoken)
+{
+    xTaskNotifyGive(task);
+    if (higherPriorityTaskWoken != nullptr) { *higherPriorityTaskWoken = pdTRUE; }
+}
+
+std::uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait)
+{
+    Task&            self = Logging::Host::current();
+    std::unique_lock lock(self.mutex);
+    Logging::Host::waitFor(self.changed, lock, ticksToWait, [&self] { return self.notifyValue != 0 || self.deleted; });
+    self.checkDeleted();
+
+    const std::uint32_t value = self.notifyValue;
+    if (value != 0) { self.notifyValue = clearCountOnExit != pdFALSE ? 0 : value - 1; }
+    return value;
+}
+
+void vTaskSetTimeOutState(TimeOut_t* timeOut)
+{
+    timeOut->timeOnEntering = xTaskGetTickCount();
+}
+
+BaseType_t xTaskCheckForTimeOut(TimeOut_t* timeOut, TickType_t* ticksToWait)
+{
+    if (*ticksToWait == portMAX_DELAY) { return pdFALSE; }
+
+    const TickType_t now     = xTaskGetTickCount();
+    const TickType_t elapsed = now - timeOut->timeOnEntering;
+    if (elapsed >= *ticksToWait) {
+        *ticksToWait = 0;
+        return pdTRUE;
+    }
+    *ticksToWait -= elapsed;
+    timeOut->timeOnEntering = now;
+    return pdFALSE;
+}
+
+namespace {
+SemaphoreHandle_t createSemaphore(StaticSemaphore_t* buffer, unsigned int count)
+{
+    Semaphore* semaphore = nullptr;
+    if (buffer != nullptr) {
+        semaphore           = new (&buffer->storage[0]) Semaphore;
+        semaphore->isStatic = true;
+    }
+    else {
+        void* storage = pvPortMalloc(sizeof(Semaphore));
+        if (storage == nullptr) { return nullptr; }
+        semaphore = new (storage) Semaphore;
+    }
+    semaphore->count = count;
+    return semaphore;
+}
+}    // namespace
+
+SemaphoreHandle_t xSemaphoreCreateMutex()
+{
+    return createSemaphore(nullptr, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t* buffer)
+{
+    return createSemaphore(buffer, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary()
+{
+    return createSemaphore(nullptr, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t* buffer)
+{
+    return createSemaphore(buffer, 0);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore)
+{
+    const bool isStatic = semaphore->isStatic;
+    semaphore->~Semaphore();
+    if (!isStatic) { vPortFree(semaphore); }
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticksToWait)
+{
+    std::unique_lock lock(semaphore->mutex);
+    if (!Logging::Host::waitFor(
+          semaphore->changed, lock, ticksToWait, [semaphore] { return semaphore->count != 0; })) {
+        return pdFAIL;
+    }
+    semaphore->count--;
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore)
+{
+    std::scoped_lock lock(semaphore->mutex);
+    if (semaphore->count != 0) { return pdFAIL; }
+    semaphore->count = 1;
+    semaphore->changed.notify_one();
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreTakeFromISR(SemaphoreHandle_t semaphore, BaseType_t* /*higherPriorityTaskWoken*/)
+{
+    return xSemaphoreTake(semaphore, 0);
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t* higherPriorityTaskWoken)
+{
+    if (higherPriorityTaskWoken != nullptr) { *higherPriorityTaskWoken = pdTRUE; }
+    return xSemaphoreGive(semaphore);
+}
@@ -0,0 +1,153 @@
+/**
+ * @file    hal_host.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Fake UART and USB CDC drivers.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#include "transfer_log.h"
+#include "usart.h"
+#include "usbd_cdc_if.h"
+
+#include "FreeRTOS.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+
+namespace Logging::Host {
+void TransferLog::setKeepBytes(bool keepBytes)
+{
+    std::scoped_lock lock(m_lock);
+    m_keepBytes = keepBytes;
+}
+
+void TransferLog::record(const void* data, std::size_t length, std::uint64_t startNs, std::uint64_t endNs)
+{
+    std::scoped_lock lock(m_lock);
+    m_transfers.push_back({startNs, endNs, m_byteCount, length});
+    if (m_keepBytes) { m_bytes.append(static_cast<const char*>(data), length); }
+    m_byteCount += length;
+}
+
+void TransferLog::clear()
+{
+    std::scoped_lock lock(m_lock);
+    m_bytes.clear();
+    m_transfers.clear();
+    m_byteCount = 0;
+}
+
+std::string TransferLog::bytes() const
+{
+    std::scoped_lock lock(m_lock);
+    return m_bytes;
+}
+
+std::vector<TransferLog::Transfer> TransferLog::transfers() const
+{
+    std::scoped_lock lock(m_lock);
+    return m_transfers;
+}
+
+std::size_t TransferLog::byteCount() const
+{
+    std::scoped_lock lock(m_lock);
+    return m_byteCount;
+}
+
+std::size_t TransferLog::transferCount() const
+{
+    std::scoped_lock lock(m_lock);
+    return m_transfers.size();
+}
+
+std::uint64_t TransferLog::now()
+{
+    return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count());
+}
+
+namespace {
+std::uint64_t wireTimeNs(const UART_HandleTypeDef& huart, std::size_t length)
+{
+    if (huart.baudRate == 0) { return 0; }
+    return static_cast<std::uint64_t>(length) * 10 * 1'000'000'000 / huart.baudRate;
+}
+}    // namespace
+}    // namespace Logging::Host
+
+using Logging::Host::TransferLog;
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef* huart,
+                                    const std::uint8_t* data,
+                                    std::uint16_t       size,
+                                    std::uint32_t /*timeout*/)
+{
+    const std::uint64_t start = TransferLog::now();
+    const std::uint64_t end   = start + Logging::Host::wireTimeNs(*huart, size);
+    while (TransferLog::now() < end) {}
+    huart->tx.record(data, size, start, end);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef* huart, const std::uint8_t* data, std::uint16_t size)
+{
+    if (huart->failTransmit) { return HAL_ERROR; }
+    if (huart->dmaBusy.exchange(true)) { return HAL_BUSY; }
+
+    const std::uint64_t start = TransferLog::now();
+    const std::uint64_t end   = start + Logging::Host::wireTimeNs(*huart, size);
+    huart->tx.record(data, size, start, end);
+    // The "DMA" completes on its own thread, like an interrupt would preempt whoever is running.
+    std::thread([huart, end] {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(end - TransferLog::now()));
+        Logging::Host::InterruptScope isr;
+        huart->dmaBusy = false;
+        HAL_UART_TxCpltCallback(huart);
+    }).detach();
+    return HAL_OK;
+}
+
+__attribute__((weak)) void HAL_UART_TxCpltCallback(UART_HandleTypeDef* /*huart*/)
+{
+}
+
+std::uint32_t HAL_GetTick()
+{
+    return static_cast<std::uint32_t>(TransferLog::now() / 1'000'000);
+}
+
+std::uint8_t CDC_Queue(CDC_DeviceInfo* cdc, std::uint8_t* data, std::size_t length)
+{
+    std::scoped_lock lock(cdc->queueLock);
+    if (cdc->queue.size() + length > cdc->txBufferSize) { return USBD_BUSY; }
+    cdc->queue.append(reinterpret_cast<const char*>(data), length);
+    return USBD_OK;
+}
+
+std::uint8_t CDC_SendQueue(CDC_DeviceInfo* cdc)
+{
+    std::scoped_lock lock(cdc->queueLock);
+    if (!cdc->hostReading || cdc->queue.empty()) { return USBD_OK; }
+    const std::uint64_t now = TransferLog::now();
+    cdc->tx.record(cdc->queue.data(), cdc->queue.size(), now, now);
+    cdc->queue.clear();
+    return USBD_OK;
+}
+
+std::size_t CDC_GetTxBufferSize(CDC_DeviceInfo* cdc)
+{
+    return cdc->txBufferSize;
+}
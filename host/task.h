@@ -0,0 +1,74 @@
+/**
+ * @file    task.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Host stand-in for the FreeRTOS task API, tasks are POSIX threads.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#ifndef VENDOR_LOGGING_HOST_TASK_H
+#define VENDOR_LOGGING_HOST_TASK_H
+
+#include "FreeRTOS.h"
+
+namespace Logging::Host {
+struct Task;
+}    // namespace Logging::Host
+
+using TaskHandle_t   = Logging::Host::Task*;
+using TaskFunction_t = void (*)(void*);
+
+struct TimeOut_t {
+    TickType_t timeOnEntering;
+};
+
+/**
+ * Tasks are detached POSIX threads. Threads that weren't created by xTaskCreate (e.g. main() or std::thread) become
+ * tasks the first time they call into this API.
+ *
+ * Priorities are only recorded, the host's scheduler decides who runs.
+ */
+BaseType_t   xTaskCreate(TaskFunction_t       function,
+                         const char*          name,
+                         configSTACK_DEPTH_TYPE stackDepth,
+                         void*                parameters,
+                         UBaseType_t          priority,
+                         TaskHandle_t*        createdTask);
+TaskHandle_t xTaskCreateStatic(TaskFunction_t function,
+                               const char*    name,
+                               std::uint32_t  stackDepth,
+                               void*          parameters,
+                               UBaseType_t    priority,
+                               StackType_t*   stack,
+                               StaticTask_t*  taskBuffer);
+/**
+ * Deletes a task created by xTaskCreate(Static). The task is gone when this returns: it stops at its next blocking call
+ * (vTaskDelay, ulTaskNotifyTake) and its thread unwinds.
+ */
+void vTaskDelete(TaskHandle_t task);
+
+TaskHandle_t xTaskGetCurrentTaskHandle();
+void         vTaskPrioritySet(TaskHandle_t task, UBaseType_t priority);
+UBaseType_t  uxTaskPriorityGet(TaskHandle_t task);
+
+void       vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount();
+TickType_t xTaskGetTickCountFromISR();
+
+BaseType_t    xTaskNotifyGive(TaskHandle_t task);
+void          vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higherPriorityTaskWoken);
+std::uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait);
+
+void       vTaskSetTimeOutState(TimeOut_t* timeOut);
+BaseType_t xTaskCheckForTimeOut(TimeOut_t* timeOut, TickType_t* ticksToWait);
+
+#endif    // VENDOR_LOGGING_HOST_TASK_H
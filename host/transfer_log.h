@@ -0,0 +1,63 @@
+/**
+ * @file    transfer_log.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Record of the bytes sent by the fake HAL and CDC drivers.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#ifndef VENDOR_LOGGING_HOST_TRANSFER_LOG_H
+#define VENDOR_LOGGING_HOST_TRANSFER_LOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Logging::Host {
+/**
+ * Bytes sent through a fake peripheral, along with when each transfer started and ended. Thread-safe.
+ */
+class TransferLog {
+public:
+    struct Transfer {
+        std::uint64_t startNs;    //!< Since an arbitrary epoch, see now().
+        std::uint64_t endNs;
+        std::size_t   offset;    //!< Of the first byte in bytes().
+        std::size_t   length;
+    };
+
+    //! Keep only the transfers and the byte count, e.g. for long benchmarks.
+    void setKeepBytes(bool keepBytes);
+
+    void record(const void* data, std::size_t length, std::uint64_t startNs, std::uint64_t endNs);
+    void clear();
+
+    [[nodiscard]] std::string           bytes() const;
+    [[nodiscard]] std::vector<Transfer> transfers() const;
+    [[nodiscard]] std::size_t           byteCount() const;
+    [[nodiscard]] std::size_t           transferCount() const;
+
+    //! Steady clock, in nanoseconds.
+    static std::uint64_t now();
+
+private:
+    mutable std::mutex    m_lock;
+    bool                  m_keepBytes = true;
+    std::string           m_bytes;
+    std::vector<Transfer> m_transfers;
+    std::size_t           m_byteCount = 0;
+};
+}    // namespace Logging::Host
+
+#endif    // VENDOR_LOGGING_HOST_TRANSFER_LOG_H
@@ -0,0 +1,65 @@
+/**
+ * @file    usart.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Fake of the STM32 HAL UART driver, recording what is sent.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#ifndef VENDOR_LOGGING_HOST_USART_H
+#define VENDOR_LOGGING_HOST_USART_H
+
+#include "transfer_log.h"
+
+#include <atomic>
+#include <cstdint>
+
+typedef enum {
+    HAL_OK      = 0x00U,
+    HAL_ERROR   = 0x01U,
+    HAL_BUSY    = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+#define HAL_MAX_DELAY 0xFFFFFFFFU
+
+/**
+ * A UART, on the host. The bytes are recorded in `tx` rather than sent anywhere.
+ */
+struct UART_HandleTypeDef {
+    //! The transfers take as long as they would at that rate, with 10 bits per byte. 0 to make them instantaneous.
+    std::uint32_t baudRate = 0;
+    //! Makes HAL_UART_Transmit_DMA fail, e.g. to test the error paths.
+    std::atomic<bool> failTransmit = false;
+
+    Logging::Host::TransferLog tx;
+
+    //! Set while a DMA transfer is in progress. Cleared right before HAL_UART_TxCpltCallback is called.
+    std::atomic<bool> dmaBusy = false;
+};
+
+//! Sends the data, busy-waiting for as long as it takes on the wire like the real driver.
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef* huart, const std::uint8_t* data, std::uint16_t size,
+                                    std::uint32_t timeout);
+
+/**
+ * Starts sending the data in the background. HAL_UART_TxCpltCallback is called from a simulated interrupt (see
+ * Logging::Host::InterruptScope) once the transfer would be complete.
+ */
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef* huart, const std::uint8_t* data, std::uint16_t size);
+
+//! Weak, like the HAL's: define it to be told about the completed DMA transfers.
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef* huart);
+
+std::uint32_t HAL_GetTick();
+
+#endif    // VENDOR_LOGGING_HOST_USART_H
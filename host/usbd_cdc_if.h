@@ -0,0 +1,52 @@
+/**
+ * @file    usbd_cdc_if.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Fake of the USB CDC class interface, recording what is sent.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#ifndef VENDOR_LOGGING_HOST_USBD_CDC_IF_H
+#define VENDOR_LOGGING_HOST_USBD_CDC_IF_H
+
+#include "transfer_log.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#define USBD_OK   0U
+#define USBD_BUSY 1U
+#define USBD_FAIL 3U
+
+/**
+ * A CDC interface, on the host. CDC_Queue appends to a bounded transmit queue, CDC_SendQueue moves its content to `tx`
+ * as if the USB host had read it.
+ */
+struct CDC_DeviceInfo {
+    std::size_t txBufferSize = 2048;
+    //! When false, nobody reads the interface: the queue fills up and CDC_Queue starts failing.
+    std::atomic<bool> hostReading = true;
+
+    Logging::Host::TransferLog tx;
+
+    std::mutex  queueLock;
+    std::string queue;
+};
+
+std::uint8_t CDC_Queue(CDC_DeviceInfo* cdc, std::uint8_t* data, std::size_t length);
+std::uint8_t CDC_SendQueue(CDC_DeviceInfo* cdc);
+std::size_t  CDC_GetTxBufferSize(CDC_DeviceInfo* cdc);
+
+#endif    // VENDOR_LOGGING_HOST_USBD_CDC_IF_H
@@ -0,0 +1,227 @@
+/**
+ * @file    laned_ring.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Rings with a lane per producer task, merged by the consumer.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef VENDOR_LOGGING_LANED_RING_H
+#define VENDOR_LOGGING_LANED_RING_H
+
+#include "mpsc_ring.h"
+#include "port.h"
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Logging {
+/**
+ * Set of rings with the same interface as MpscRing, where each registered task, and the interrupts of each registered
+ * priority, produce in a lane of their own.
+ *
+ * Registered producers never touch the same memory as other ones, so a burst from one of them doesn't make the others
+ * retry or wait for room. Interrupts of the same priority don't preempt each other, so their lane has a single producer
+ * at a time too. The other tasks and interrupts share lane 0. Every lane is an MpscRing, safe for concurrent producers
+ * whatever is registered.
+ *
+ * Every record is numbered when it is reserved, and the consumer merges the lanes by taking the lowest number among the
+ * records at the front of the lanes. A record still being written by a preempted producer doesn't hold the other lanes
+ * back: it is delivered once it is committed, possibly after records that were reserved later. The order of the
+ * records of a given producer is always kept.
+ *
+ * @tparam Capacity Size of each lane in bytes, must be a power of two. Each record takes 4 more bytes for its number.
+ * @tparam TaskLanes Number of tasks that can be registered, see registerProducer.
+ * @tparam InterruptLanes Number of interrupt priorities that can be registered, see registerInterruptPriority.
+ */
+template<std::size_t Capacity, std::size_t TaskLanes, std::size_t InterruptLanes = 0>
+class LanedRing {
+    using Lane = MpscRing<Capacity>;
+
+    static constexpr std::size_t s_laneCount    = TaskLanes + InterruptLanes + 1;
+    static constexpr std::size_t s_sequenceSize = sizeof(std::uint32_t);
+
+    Lane                      m_lanes[s_laneCount];
+    std::atomic<TaskHandle_t> m_owners[TaskLanes] = {};    //!< Task producing in lane i + 1.
+    //! Priority + 1 of the interrupts producing in lane TaskLanes + i + 1, 0 if the lane is free.
+    std::array<std::atomic<std::uint16_t>, InterruptLanes> m_interruptOwners = {};
+    std::atomic<std::uint32_t>                             m_sequence        = 0;
+
+public:
+    struct Record {
+        const char*   data     = nullptr;
+        std::size_t   length   = 0;
+        std::uint32_t sequence = 0;    //!< Order in which the record was reserved, across all the lanes.
+    };
+
+    static constexpr std::size_t s_maxLength = Lane::s_maxLength - s_sequenceSize;
+
+    /**
+     * Gives a task a lane of its own. Must be called before the task logs anything through this ring.
+     * @param task The task, or nullptr for the calling task.
+     * @return False if every lane is taken, the task keeps using the shared lane then.
+     */
+    bool registerProducer(TaskHandle_t task = nullptr)
+    {
+        if (task == nullptr) { task = xTaskGetCurrentTaskHandle(); }
+        for (auto& owner : m_owners) {
+            TaskHandle_t expected = nullptr;
+            if (owner.load(std::memory_order_relaxed) == task ||
+                owner.compare_exchange_strong(expected, task, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Gives the lane of a task back, e.g. before deleting the task. The records it holds are still delivered.
+     * @param task The task, or nullptr for the calling task. Must not be logging anymore.
+     */
+    void unregisterProducer(TaskHandle_t task = nullptr)
+    {
+        if (task == nullptr) { task = xTaskGetCurrentTaskHandle(); }
+        for (auto& owner : m_owners) {
+            TaskHandle_t expected = task;
+            owner.compare_exchange_strong(expected, nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Gives the interrupts of a priority a lane of their own. Must be called before they log anything through this
+     * ring.
+     * @param priority As given to HAL_NVIC_SetPriority, see Port::interruptPriority.
+     * @return False if every interrupt lane is taken, these interrupts keep using the shared lane then.
+     */
+    bool registerInterruptPriority(std::uint8_t priority)
+    {
+        const auto owner = static_cast<std::uint16_t>(priority + 1);
+        for (auto& interruptOwner : m_interruptOwners) {
+            std::uint16_t expected = 0;
+            if (interruptOwner.load(std::memory_order_relaxed) == owner ||
+                interruptOwner.compare_exchange_strong(expected, owner, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //! See MpscRing::reserve, `limit` applies to the lane of the caller.
+    char* reserve(std::size_t length, std::size_t limit = Capacity)
+    {
+        if (length > s_maxLength) { return nullptr; }
+        char* data = m_lanes[currentLane()].reserve(s_sequenceSize + length, limit);
+        if (data == nullptr) { return nullptr; }
+
+        const std::uint32_t sequence = m_sequence.fetch_add(1, std::memory_order_relaxed);
+        std::memcpy(data, &sequence, sizeof(sequence));
+        return data + s_sequenceSize;
+    }
+
+    //! See MpscRing::commit.
+    void commit(char* data)
+    {
+        char* record = data - s_sequenceSize;
+        laneOf(record).commit(record);
+    }
+
+    //! See MpscRing::commit.
+    void commit(char* data, std::size_t length)
+    {
+        char* record = data - s_sequenceSize;
+        laneOf(record).commit(record, s_sequenceSize + length);
+    }
+
+    //! See MpscRing::used, for all the lanes.
+    std::size_t used() const
+    {
+        std::size_t used = 0;
+        for (const auto& lane : m_lanes) {
+            used += lane.used();
+        }
+        return used;
+    }
+
+    //! See MpscRing::read, the record with the lowest number at the front of the lanes is read.
+    bool read(Record& record)
+    {
+        std::size_t   oldest         = s_laneCount;
+        std::uint32_t oldestSequence = 0;
+        for (std::size_t i = 0; i < s_laneCount; i++) {
+            typename Lane::Record front;
+            if (!m_lanes[i].peek(front)) { continue; }
+
+            std::uint32_t sequence;
+            std::memcpy(&sequence, front.data, sizeof(sequence));
+            // The numbers wrap around, compare their distance.
+            if (oldest == s_laneCount || static_cast<std::int32_t>(sequence - oldestSequence) < 0) {
+                oldest         = i;
+                oldestSequence = sequence;
+            }
+        }
+        if (oldest == s_laneCount) { return false; }
+
+        typename Lane::Record front;
+        m_lanes[oldest].read(front);
+        record = {front.data + s_sequenceSize, front.length - s_sequenceSize, oldestSequence};
+        return true;
+    }
+
+    //! See MpscRing::release.
+    void release()
+    {
+        for (auto& lane : m_lanes) {
+            lane.release();
+        }
+    }
+
+private:
+    std::size_t currentLane() const
+    {
+        if (Port::isInIsr()) {
+            const auto owner = static_cast<std::uint16_t>(Port::interruptPriority() + 1);
+            for (std::size_t i = 0; i < InterruptLanes; i++) {
+                if (m_interruptOwners[i].load(std::memory_order_relaxed) == owner) { return TaskLanes + i + 1; }
+            }
+            return 0;
+        }
+        const TaskHandle_t task = xTaskGetCurrentTaskHandle();
+        for (std::size_t i = 0; i < TaskLanes; i++) {
+            if (m_owners[i].load(std::memory_order_relaxed) == task) { return i + 1; }
+        }
+        return 0;
+    }
+
+    Lane& laneOf(const char* record)
+    {
+        const auto offset = static_cast<std::size_t>(record - reinterpret_cast<const char*>(&m_lanes[0]));
+        return m_lanes[offset / sizeof(Lane)];
+    }
+};
+
+/**
+ * Adapts LanedRing to the Queue parameter of MtSink, e.g. `MtSink<UartSink, 1024, Lanes<4, 2>::Ring>` gives 4 tasks and
+ * the interrupts of 2 priorities a 1024 bytes lane of their own, and the others a shared one.
+ */
+template<std::size_t TaskLanes, std::size_t InterruptLanes = 0>
+struct Lanes {
+    template<std::size_t Capacity>
+    using Ring = LanedRing<Capacity, TaskLanes, InterruptLanes>;
+};
+}    // namespace Logging
+
+#endif    // VENDOR_LOGGING_LANED_RING_H
@@ -30,7 +30,7 @@ enum class Level : std::uint8_t {
     all,
 };
 
-static char levelToChar(Level level)
+inline char levelToChar(Level level)
 {
     switch (level) {
         case Level::error: return 'E';
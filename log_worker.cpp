@@ -0,0 +1,116 @@
+/**
+ * @file    log_worker.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Task serving the queues of several sinks.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#include "log_worker.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace Logging {
+LogWorkerBase::LogWorkerBase()
+{
+    m_lock = xSemaphoreCreateMutexStatic(&m_lockBuffer);
+    configASSERT(m_lock != nullptr);
+}
+
+LogWorkerBase::~LogWorkerBase()
+{
+    vSemaphoreDelete(m_lock);
+}
+
+void LogWorkerBase::add(Client& client)
+{
+    xSemaphoreTake(m_lock, portMAX_DELAY);
+    client.m_next = m_clients;
+    m_clients     = &client;
+    xSemaphoreGive(m_lock);
+    // It might have queued messages already.
+    xTaskNotifyGive(m_task);
+}
+
+void LogWorkerBase::remove(Client& client)
+{
+    xSemaphoreTake(m_lock, portMAX_DELAY);
+    for (Client** it = &m_clients; *it != nullptr; it = &(*it)->m_next) {
+        if (*it == &client) {
+            *it = client.m_next;
+            break;
+        }
+    }
+    client.m_next = nullptr;
+    xSemaphoreGive(m_lock);
+}
+
+void LogWorkerBase::stop()
+{
+    configASSERT(m_clients == nullptr);
+    if (m_taskIsRunning && m_task != nullptr) {
+        // Ask the task to shut down.
+        m_taskShouldRun = false;
+        xTaskNotifyGive(m_task);
+        // Increase its priority to ours +1 so that it can stop sooner.
+        vTaskPrioritySet(m_task, uxTaskPriorityGet(nullptr) + 1);
+        while (m_taskIsRunning) {
+            portYIELD();
+        }
+    }
+#if LOGGER_STATIC_CONFIG
+    // The task's stack and TCB are members, it must be gone before they are.
+    if (m_task != nullptr) { vTaskDelete(m_task); }
+#endif
+}
+
+TickType_t LogWorkerBase::serveAll()
+{
+    TickType_t wait = portMAX_DELAY;
+    xSemaphoreTake(m_lock, portMAX_DELAY);
+    for (Client* client = m_clients; client != nullptr; client = client->m_next) {
+        wait = std::min(wait, client->serve());
+    }
+    xSemaphoreGive(m_lock);
+    return wait;
+}
+
+void LogWorkerBase::task(void* args)
+{
+    configASSERT(args != nullptr);
+
+    auto& that = *static_cast<LogWorkerBase*>(args);
+    // m_task is set by the constructor, possibly after we start running. Nobody notifies us before it returns: the
+    // clients are added once the worker is constructed.
+    that.m_taskIsRunning = true;
+
+    TickType_t wait = portMAX_DELAY;
+    while (that.m_taskShouldRun) {
+        // Sleep until a client queues something or has to be served again, not at all if a client has more to do.
+        if (wait != 0) { ulTaskNotifyTake(pdTRUE, wait); }
+        wait = that.serveAll();
+    }
+
+    that.m_taskIsRunning = false;
+    // `that` is now dangling, do not use it anymore!
+#if LOGGER_STATIC_CONFIG
+    // The destructor deletes us, our stack and TCB belong to `that`.
+    while (true) {
+        vTaskDelay(portMAX_DELAY);
+    }
+#else
+    vTaskDelete(nullptr);
+    std::unreachable();
+#endif
+}
+}    // namespace Logging
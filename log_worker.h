@@ -0,0 +1,137 @@
+/**
+ * @file    log_worker.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Task serving the queues of several sinks.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef VENDOR_LOGGING_LOG_WORKER_H
+#define VENDOR_LOGGING_LOG_WORKER_H
+
+#include "config.h"
+
+#include <FreeRTOS.h>
+#include <semphr.h>
+#include <task.h>
+
+#include <atomic>
+#include <cstddef>
+
+namespace Logging {
+/**
+ * Task serving the queues of several sinks, instead of each of them having a task and a stack of its own, see
+ * MtSinkPolicy::sharedWorker.
+ *
+ * The task sleeps until a client notifies it, or until the earliest deadline given by the clients, e.g. to flush their
+ * sink. With nothing queued, it doesn't wake up at all, which lets a tickless idle keep the CPU asleep. The clients are
+ * served in turn, one batch each, so that a busy sink doesn't hold the others back.
+ *
+ * The stack and the priority of the task are set by LogWorker.
+ */
+class LogWorkerBase {
+public:
+    //! A queue served by the worker.
+    class Client {
+        friend class LogWorkerBase;
+        Client* m_next = nullptr;
+
+    protected:
+        ~Client() = default;
+
+        /**
+         * Delivers a batch of queued messages. Called from the worker's task.
+         * @return Ticks until the client must be served again even if it isn't notified, 0 if it has more to deliver
+         * right away, portMAX_DELAY if it only needs to be served once notified.
+         */
+        virtual TickType_t serve() = 0;
+    };
+
+    LogWorkerBase(const LogWorkerBase&)            = delete;
+    LogWorkerBase& operator=(const LogWorkerBase&) = delete;
+    LogWorkerBase(LogWorkerBase&&)                 = delete;
+    LogWorkerBase& operator=(LogWorkerBase&&)      = delete;
+
+    //! Task to notify with xTaskNotifyGive when a client has something queued.
+    [[nodiscard]] TaskHandle_t taskHandle() const { return m_task; }
+
+    /**
+     * Starts serving a client.
+     * @param client Must be removed before it is destroyed.
+     */
+    void add(Client& client);
+
+    /**
+     * Stops serving a client. If the client is being served, waits for its batch to be delivered. Must not be called
+     * from the worker's task, i.e. from a sink.
+     */
+    void remove(Client& client);
+
+protected:
+    LogWorkerBase();
+    ~LogWorkerBase();
+
+    //! Stops the task, which must be done before its stack goes away. Every client must have been removed.
+    void stop();
+
+    [[noreturn]] static void task(void* args);
+
+    TaskHandle_t m_task = nullptr;
+
+private:
+    TickType_t serveAll();
+
+    Client*           m_clients = nullptr;
+    SemaphoreHandle_t m_lock    = nullptr;    //!< Held while the clients are served or changed.
+    StaticSemaphore_t m_lockBuffer {};
+
+    std::atomic<bool> m_taskShouldRun = true;
+    std::atomic<bool> m_taskIsRunning = false;
+};
+
+/**
+ * LogWorkerBase with its task.
+ * @tparam StackBudget Room left on the task's stack for the clients, in bytes: the largest batch of the MtSinks served
+ * (see MtSinkPolicy::batchMaxCount) and the stack used by their sinks.
+ * @tparam Priority Priority of the task, low by default.
+ */
+template<std::size_t StackBudget = 512, UBaseType_t Priority = 1>
+class LogWorker : public LogWorkerBase {
+    static constexpr std::size_t s_taskStackSize =
+      configMINIMAL_STACK_SIZE + (StackBudget / sizeof(configSTACK_DEPTH_TYPE));
+
+#if LOGGER_STATIC_CONFIG
+    StackType_t  m_taskStack[s_taskStackSize];
+    StaticTask_t m_taskBuffer;
+#endif
+
+public:
+    LogWorker()
+    {
+        auto* base = static_cast<LogWorkerBase*>(this);
+#if LOGGER_STATIC_CONFIG
+        m_task = xTaskCreateStatic(&task, "LogWorker", s_taskStackSize, base, Priority, &m_taskStack[0], &m_taskBuffer);
+        configASSERT(m_task != nullptr);
+#else
+        [[maybe_unused]] auto res = xTaskCreate(&task, "LogWorker", s_taskStackSize, base, Priority, &m_task);
+        configASSERT(res == pdPASS);
+#endif
+    }
+    LogWorker(const LogWorker&)            = delete;
+    LogWorker& operator=(const LogWorker&) = delete;
+    LogWorker(LogWorker&&)                 = delete;
+    LogWorker& operator=(LogWorker&&)      = delete;
+
+    ~LogWorker() { stop(); }
+};
+}    // namespace Logging
+
+#endif    // VENDOR_LOGGING_LOG_WORKER_H
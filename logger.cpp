@@ -17,15 +17,67 @@
 
 #include "logger.h"
 
+#include "mini_printf.h"
+#include "port.h"
+
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cctype>
 #include <cstdarg>
-#include <cstdio>
+#include <cstring>
 
 namespace Logging {
+// Defined out of the class, which must be complete to construct them.
+Logger::Config Logger::s_defaultConfig {};
+#if LOGGER_STATIC_CONFIG
+Logger::Config Logger::s_spareConfig {};
+#endif
+
 void Logger::setGetTime(Logger::GetTimeFunc getTime)
 {
     assert(getTime != nullptr && "getTime func can't be null!");
-    s_getTime = getTime;
+    s_getTime             = getTime;
+    s_clock               = [] -> std::uint64_t { return s_getTime(); };
+    s_ticksPerSecond      = 1000;
+    s_ticksPerMillisecond = 1;
+    writeClockInfo();
+}
+
+void Logger::setClock(ClockFunc clock, std::uint64_t ticksPerSecond)
+{
+    assert(clock != nullptr && "clock func can't be null!");
+    assert(ticksPerSecond >= 1000 && "The clock must be at least as fast as a millisecond tick");
+    s_clock               = clock;
+    s_ticksPerSecond      = ticksPerSecond;
+    s_ticksPerMillisecond = ticksPerSecond / 1000;
+    writeClockInfo();
+}
+
+void Logger::writeClockInfo(Sink& sink)
+{
+#if LOGGER_USE_BINARY_FORMAT || LOGGER_USE_BINARY_BUFFER_DUMPS
+    char            buffer[16];
+    Binary::Encoder encoder {&buffer[0], sizeof(buffer)};
+    encoder.clockInfo(s_ticksPerSecond);
+    sink.onWrite(Level::none, &buffer[0], encoder.finish());
+#else
+    (void)sink;
+#endif
+}
+
+void Logger::writeClockInfo()
+{
+    const Config& config = currentConfig();
+    for (auto&& sink : config.globalSinks) {
+        writeClockInfo(*sink);
+    }
+    for (auto&& [tag, logger] : config.loggers) {
+        if (!logger.sinks.has_value()) { continue; }
+        for (auto&& sink : *logger.sinks) {
+            writeClockInfo(*sink);
+        }
+    }
 }
 
 void Logger::write(LoggerView logger, Level level, const char* fmt, ...)
@@ -36,157 +88,519 @@ void Logger::write(LoggerView logger, Level level, const char* fmt, ...)
     va_end(args);
 }
 
+namespace {
+struct VarArgs {
+    const char* fmt;
+    va_list*    args;
+};
+
+size_t formatVarArgs(char* buffer, size_t size, void* context)
+{
+    auto& [fmt, args] = *static_cast<VarArgs*>(context);
+    return Printf::vformat(buffer, size, fmt, *args);
+}
+}    // namespace
+
 void Logger::vWrite(LoggerView logger, Level level, const char* fmt, va_list args)
 {
-    if (!logger.shouldLog(level)) {
+    if (!logger.admit(level)) {
         // This level is disabled.
         return;
     }
-    static constexpr size_t maxLength = 512;
-    char                    buffer[maxLength];
-    size_t                  length = vsnprintf(&buffer[0], maxLength, fmt, args);
-    assert(length < maxLength && "String too long to be logged");
+
+    // The va_list is consumed through a pointer, copy it to get an object of type va_list whatever the ABI.
+    va_list argsCopy;
+    va_copy(argsCopy, args);
+    VarArgs context {fmt, &argsCopy};
+    dispatch(logger, level, &formatVarArgs, &context);
+    va_end(argsCopy);
+}
+
+void Logger::dispatch(LoggerView logger, Level level, FormatFunc format, void* context)
+{
+    // Format straight into the buffer of the sink if it is the only one that wants the level. Otherwise its reservation
+    // would stay open while the others write, holding back a queue that is drained in order, so every sink gets a copy.
+    Sink* target = nullptr;
+    for (auto&& sink : *logger.sinks) {
+        if (!sink->accepts(level)) { continue; }
+        if (target != nullptr) {
+            writeBuffered(logger, level, format, context);
+            return;
+        }
+        target = sink;
+    }
+    if (target == nullptr) { return; }
+
+    char* buffer = target->reserve(level, s_maxLength);
+    if (buffer == nullptr) {
+        writeBuffered(logger, level, format, context);
+        return;
+    }
+    size_t length = clampLength(format(buffer, s_maxLength, context));
+    if (length != 0) { countDelivery(*target, length); }
+    target->commit(buffer, length);
+}
+
+void Logger::writeBuffered(LoggerView logger, Level level, FormatFunc format, void* context)
+{
+    char   buffer[s_maxLength];
+    size_t length = clampLength(format(&buffer[0], s_maxLength, context));
+    writeRaw(logger, level, &buffer[0], length);
+}
+
+size_t Logger::clampLength(size_t length)
+{
+    assert(length < s_maxLength && "String too long to be logged");
+    // Truncated messages are still logged when asserts are disabled.
+    return std::min(length, s_maxLength - 1);
+}
+
+void Logger::writeRaw(LoggerView logger, Level level, const char* data, std::size_t length)
+{
+    if (length == 0) { return; }
+    for (auto&& sink : *logger.sinks) {
+        if (sink->accepts(level)) {
+            countDelivery(*sink, length);
+            sink->onWrite(level, data, length);
+        }
+    }
+}
+
+void Logger::dropTooLong(LoggerView logger, Level level)
+{
     for (auto&& sink : *logger.sinks) {
-        sink->onWrite(level, &buffer[0], length);
+        if (sink->accepts(level)) { sink->stats().drop(DropCause::tooLong); }
     }
 }
 
+void Logger::addSink(Sink& sink)
+{
+    writeClockInfo(sink);
+    update([&sink](Config& config) { addSink(config.globalSinks, sink); });
+}
+
+void Logger::clearSinks()
+{
+    update([](Config& config) { config.globalSinks.clear(); });
+}
+
+void Logger::setLevel(Level level)
+{
+    update([level](Config& config) { config.globalLevel = level; });
+}
+
+void Logger::clearLevel()
+{
+    setLevel(s_defaultLevel);
+}
+
+void Logger::addSink(std::string_view tag, Sink& sink)
+{
+    writeClockInfo(sink);
+    update([tag, &sink](Config& config) {
+        LoggerInstance* logger = loggerInstance(config, tag);
+        if (logger == nullptr) { return; }
+        if (!logger->sinks.has_value()) { logger->sinks.emplace(); }
+        addSink(*logger->sinks, sink);
+    });
+}
+
 void Logger::clearSinks(std::string_view tag)
 {
-    auto it = s_loggers.find(tag);
     // logger doesn't exist, do nothing.
-    if (it == s_loggers.end()) { return; }
-    it->second.sinks = std::nullopt;
+    if (!currentConfig().loggers.contains(tag)) { return; }
+
+    update([tag](Config& config) {
+        auto it          = config.loggers.find(tag);
+        it->second.sinks = std::nullopt;
 
-    // If the logger doesn't have a custom level, straight up delete it from the list, it is useless now.
-    if (!it->second.level.has_value()) { s_loggers.erase(it); }
+        // If the logger doesn't have a custom level, straight up delete it from the list, it is useless now.
+        if (!it->second.level.has_value()) { config.loggers.erase(it); }
+    });
 }
 
 void Logger::setLevel(std::string_view tag, Level level)
 {
-    s_loggers[tag].level = level;
+    update([tag, level](Config& config) {
+        LoggerInstance* logger = loggerInstance(config, tag);
+        if (logger != nullptr) { logger->level = level; }
+    });
 }
 
 Level Logger::getLevel(std::string_view tag)
 {
-    auto [t, level, sinks] = getLogger(tag);
-    return *level;
+    return getLogger(currentConfig(), tag).level;
 }
 
 void Logger::clearLevel(std::string_view tag)
 {
-    auto it = s_loggers.find(tag);
     // logger doesn't exist, do nothing.
-    if (it == s_loggers.end()) { return; }
-    it->second.level = std::nullopt;
+    if (!currentConfig().loggers.contains(tag)) { return; }
+
+    update([tag](Config& config) {
+        auto it          = config.loggers.find(tag);
+        it->second.level = std::nullopt;
+
+        // If the logger doesn't have custom sinks, straight up delete it from the list, it is useless now.
+        if (!it->second.sinks.has_value()) { config.loggers.erase(it); }
+    });
+}
+
+Logger::LoggerInstance* Logger::loggerInstance(Config& config, std::string_view tag)
+{
+    auto it = config.loggers.find(tag);
+    if (it == config.loggers.end()) {
+        assert(config.loggers.size() < config.loggers.max_size() && "Too many loggers, see LOGGER_MAX_LOGGERS");
+        if (config.loggers.size() == config.loggers.max_size()) { return nullptr; }
+        it = config.loggers.emplace(tag, LoggerInstance {.stats = loggerStats(tag)}).first;
+    }
+    return &it->second;
+}
 
-    // If the logger doesn't have custom sinks, straight up delete it from the list, it is useless now.
-    if (!it->second.sinks.has_value()) {
-        s_loggers.erase(it);
+LoggerStats* Logger::loggerStats(std::string_view tag)
+{
+    auto it = s_loggerStats.find(tag);
+    if (it == s_loggerStats.end()) {
+        // Once the table is full, the new tags are counted with the global logger.
+        if (s_loggerStats.size() == s_loggerStats.max_size()) { return &s_globalStats; }
+        it = s_loggerStats.emplace(tag, LoggerStats {}).first;
     }
+    return &it->second;
 }
 
-Logger::LoggerView Logger::getLogger(std::string_view tag)
+void Logger::addSink(SinkList& sinks, Sink& sink)
 {
-    LoggerView logger = {.tag = tag, .level = &s_globalLevel, .sinks = &s_globalSinks};
+    assert(sinks.size() < sinks.max_size() && "Too many sinks, see LOGGER_MAX_SINKS");
+    if (sinks.size() < sinks.max_size()) { sinks.push_back(&sink); }
+}
 
-    auto loggerIt = s_loggers.find(tag);
-    if (loggerIt != s_loggers.end()) {
-        if (loggerIt->second.level.has_value()) { logger.level = &loggerIt->second.level.value(); }
-        if (loggerIt->second.sinks.has_value()) { logger.sinks = &loggerIt->second.sinks.value(); }
+#if !LOGGER_STATIC_CONFIG
+Sink* Logger::adoptSink(std::optional<std::string_view> tag, std::unique_ptr<Sink> sink)
+{
+    Sink& adopted = *s_ownedSinks.emplace_back(std::move(sink));
+    if (tag.has_value()) { addSink(*tag, adopted); }
+    else {
+        addSink(adopted);
     }
+    return &adopted;
+}
 
-    return logger;
+void Logger::releaseUnusedSinks()
+{
+    const Config& current = currentConfig();
+    auto          isUsed  = [&current](const std::unique_ptr<Sink>& sink) {
+        auto uses = [&sink](const SinkList& sinks) { return std::ranges::find(sinks, sink.get()) != sinks.end(); };
+        return uses(current.globalSinks) || std::ranges::any_of(current.loggers, [&uses](const auto& logger) {
+                   return logger.second.sinks.has_value() && uses(*logger.second.sinks);
+               });
+    };
+    std::erase_if(s_ownedSinks, [&isUsed](const std::unique_ptr<Sink>& sink) { return !isUsed(sink); });
 }
+#endif
 
-void Logger::writeHexArray(Logger::LoggerView logger, Level level, const std::uint8_t* buff, std::size_t len)
+template<typename F>
+void Logger::update(F&& change)
 {
-    if (!logger.shouldLog(level)) { return; }
-    if (len == 0 || buff == nullptr) { return; }
-    char                hexBuffer[3 * s_bytesPerLine + 1];
-    const std::uint8_t* ptrLine      = nullptr;
-    std::size_t         bytesCurLine = 0;
+#if LOGGER_STATIC_CONFIG
+    // The snapshot before the current one isn't used anymore, the last update made sure of it.
+    Config& config = &currentConfig() == &s_defaultConfig ? s_spareConfig : s_defaultConfig;
+    config         = currentConfig();
+#else
+    auto    owned  = std::make_unique<Config>(currentConfig());
+    Config& config = *owned;
+#endif
+    config.generation++;
+    change(config);
 
-    do {
-        if (len > s_bytesPerLine) { bytesCurLine = s_bytesPerLine; }
-        else {
-            bytesCurLine = len;
-        }
-        ptrLine = buff;
+    s_config.store(&config);
+    s_generation.store(config.generation, std::memory_order_relaxed);
+#if LOGGER_STATIC_CONFIG
+    synchronize();
+#else
+    // From now on, `owned` holds the previous snapshot, unless it was the default one.
+    std::swap(s_ownedConfig, owned);
+    synchronize();
+    owned.reset();
+    releaseUnusedSinks();
+#endif
+}
 
-        for (std::size_t i = 0; i < bytesCurLine; i++) {
-            std::snprintf(&hexBuffer[0] + 3 * i, sizeof(hexBuffer) - (3 * i), "%02x ", ptrLine[i]);
+void Logger::synchronize()
+{
+    // Drain both halves in turn, flipping the epoch first so that the new readers join the other half: the readers
+    // that could still be using the previous snapshot are in either of them, and a steady stream of new readers can't
+    // keep us waiting. Before the scheduler starts, interrupts are the only readers and they are done by now.
+    for (int i = 0; i < 2; i++) {
+        const std::uint32_t epoch = s_epoch.load();
+        s_epoch.store(epoch + 1);
+        while (s_readers[epoch & 1].load() != 0) {
+            Port::delayTick();
         }
-        LOGGER_LOG_HELPER_IMPL(logger, level, "%s", &hexBuffer[0]);
-        buff += bytesCurLine;
-        len -= bytesCurLine;
-    } while (len != 0);
+    }
 }
 
-void Logger::writeCharArray(Logger::LoggerView logger, Level level, const std::uint8_t* buff, std::size_t len)
+void Logger::CallSite::refresh(const LoggerView& view, std::uint32_t generation)
 {
-    if (!logger.shouldLog(level)) { return; }
-    if (len == 0 || buff == nullptr) { return; }
-    char                charBuffer[s_bytesPerLine + 1];
-    const std::uint8_t* ptrLine      = nullptr;
-    std::size_t         bytesCurLine = 0;
+    std::uint32_t previous = m_generation.load(std::memory_order_relaxed);
+    if (previous == s_busy ||
+        !m_generation.compare_exchange_strong(previous, s_busy, std::memory_order_acquire, std::memory_order_relaxed)) {
+        return;
+    }
 
-    do {
-        if (len > s_bytesPerLine) { bytesCurLine = s_bytesPerLine; }
-        else {
-            bytesCurLine = len;
-        }
-        ptrLine = buff;
+    const char* owner = m_tag.load(std::memory_order_relaxed);
+    if (owner == nullptr || (owner == view.tag.data() && m_tagSize.load(std::memory_order_relaxed) == view.tag.size())) {
+        // The fields must not be seen changing before the cache is seen busy.
+        std::atomic_thread_fence(std::memory_order_release);
+        m_tag.store(view.tag.data(), std::memory_order_relaxed);
+        m_tagSize.store(view.tag.size(), std::memory_order_relaxed);
+        m_level.store(view.level, std::memory_order_relaxed);
+        m_sinks.store(view.sinks, std::memory_order_relaxed);
+        m_stats.store(view.stats, std::memory_order_relaxed);
+        previous = generation;
+    }
+    m_generation.store(previous, std::memory_order_release);
+}
 
-        for (std::size_t i = 0; i < bytesCurLine; i++) {
-            sprintf(&charBuffer[0] + i, "%c", ptrLine[i]);
+Logger::LoggerSnapshots Logger::snapshotStats()
+{
+    auto snapshotSinks = [](const SinkList& sinks) {
+        SinkSnapshots snapshots;
+        snapshots.reserve(sinks.size());
+        for (auto&& sink : sinks) {
+            snapshots.push_back(sink->snapshotStats());
         }
-        LOGGER_LOG_HELPER_IMPL(logger, level, "%s", &charBuffer[0]);
-        buff += bytesCurLine;
-        len -= bytesCurLine;
-    } while (len != 0);
+        return snapshots;
+    };
+
+    const Config&   config = currentConfig();
+    LoggerSnapshots snapshots;
+    snapshots.reserve(config.loggers.size() + 1);
+    snapshots.push_back({.tag = {}, .stats = s_globalStats.snapshot(), .sinks = snapshotSinks(config.globalSinks)});
+    for (auto&& [tag, logger] : config.loggers) {
+        snapshots.push_back({.tag   = tag,
+                             .stats = logger.stats->snapshot(),
+                             .sinks = logger.sinks.has_value() ? snapshotSinks(*logger.sinks) : SinkSnapshots {}});
+    }
+    return snapshots;
+}
+
+Logger::LoggerView Logger::getLogger(const Config& config, std::string_view tag)
+{
+    LoggerView logger = {.tag = tag, .level = config.globalLevel, .sinks = &config.globalSinks, .stats = &s_globalStats};
+
+    auto loggerIt = config.loggers.find(tag);
+    if (loggerIt != config.loggers.end()) {
+        logger.stats = loggerIt->second.stats;
+        if (loggerIt->second.level.has_value()) { logger.level = *loggerIt->second.level; }
+        if (loggerIt->second.sinks.has_value()) { logger.sinks = &*loggerIt->second.sinks; }
+    }
+
+    return logger;
+}
+
+void Logger::writeHexArray(Logger::LoggerView logger, Level level, const std::uint8_t* buff, std::size_t len)
+{
+    writeDump(logger, level, Binary::DumpKind::hex, buff, len);
+}
+
+void Logger::writeCharArray(Logger::LoggerView logger, Level level, const std::uint8_t* buff, std::size_t len)
+{
+    writeDump(logger, level, Binary::DumpKind::chars, buff, len);
 }
 
 void Logger::writeHexdumpArray(Logger::LoggerView logger, Level level, const std::uint8_t* buff, std::size_t len)
 {
-    if (!logger.shouldLog(level)) { return; }
-    if (len == 0 || buff == nullptr) { return; }
-    const std::uint8_t* ptrLine = nullptr;
-    // format: field[length]
-    //  ADDR[10]+"   "+DATA_HEX[8*3]+" "+DATA_HEX[8*3]+"  |"+DATA_CHAR[8]+"|"
-    char        hdBuffer[10 + 3 + s_bytesPerLine * 3 + 3 + s_bytesPerLine + 1 + 1];
-    char*       ptrHd        = nullptr;
-    std::size_t bytesCurLine = 0;
+    writeDump(logger, level, Binary::DumpKind::hexdump, buff, len);
+}
 
-    do {
-        if (len > s_bytesPerLine) { bytesCurLine = s_bytesPerLine; }
-        else {
-            bytesCurLine = len;
-        }
-        ptrLine = buff;
-        ptrHd   = &hdBuffer[0];
-
-        ptrHd += std::sprintf(ptrHd, "%p ", reinterpret_cast<const void*>(buff));
-        for (std::size_t i = 0; i < s_bytesPerLine; i++) {
-            if ((i & 7) == 0) { ptrHd += std::sprintf(ptrHd, " "); }
-            if (i < bytesCurLine) { ptrHd += std::sprintf(ptrHd, " %02x", ptrLine[i]); }
-            else {
-                ptrHd += std::sprintf(ptrHd, "   ");
+namespace {
+#if !LOGGER_USE_BINARY_BUFFER_DUMPS
+// Both digits of every byte, so that encoding a byte is a single lookup.
+constexpr auto s_hexPairs = [] {
+    std::array<std::array<char, 2>, 256> pairs {};
+    for (std::size_t i = 0; i < pairs.size(); i++) {
+        pairs[i] = {"0123456789abcdef"[i >> 4], "0123456789abcdef"[i & 0xF]};
+    }
+    return pairs;
+}();
+
+char* appendHex(char* out, std::uint8_t byte)
+{
+    std::memcpy(out, s_hexPairs[byte].data(), 2);
+    return out + 2;
+}
+
+//! Same as %p: 0x followed by the address, without leading zeros.
+char* appendAddress(char* out, const void* address)
+{
+    auto value = reinterpret_cast<std::uintptr_t>(address);
+    *out++     = '0';
+    *out++     = 'x';
+    int shift  = static_cast<int>(sizeof(value) * 8) - 4;
+    while (shift > 0 && ((value >> shift) & 0xF) == 0) {
+        shift -= 4;
+    }
+    for (; shift >= 0; shift -= 4) {
+        *out++ = "0123456789abcdef"[(value >> shift) & 0xF];
+    }
+    return out;
+}
+#endif
+
+struct Dump {
+    Binary::DumpKind    kind;
+    const std::uint8_t* data;
+    std::size_t         length;
+    std::size_t         bytesPerLine;
+    const char*         prefix       = nullptr;
+    std::size_t         prefixLength = 0;
+    // Blob records only.
+    Level            level     = Level::none;
+    std::uint64_t    timestamp = 0;
+    std::string_view tag       = {};
+};
+
+#if !LOGGER_USE_BINARY_BUFFER_DUMPS
+//! Longest line, the address, spaces and characters of a hexdump line of up to 16 bytes.
+constexpr std::size_t s_maxLineLength = 2 + 2 * sizeof(void*) + 1 + 2 + 3 * 16 + 3 + 16 + 1;
+
+//! Renders the next line of a dump, without prefix nor line ending.
+char* renderLine(char* out, Dump& dump)
+{
+    const std::uint8_t* line  = dump.data;
+    const std::size_t   count = std::min(dump.length, dump.bytesPerLine);
+
+    switch (dump.kind) {
+        case Binary::DumpKind::hex:
+            for (std::size_t i = 0; i < count; i++) {
+                out    = appendHex(out, line[i]);
+                *out++ = ' ';
             }
+            break;
+        case Binary::DumpKind::chars: {
+            // Each line stops at its first null byte, like a string would.
+            const std::uint8_t* end = std::find(line, line + count, 0);
+            std::memcpy(out, line, static_cast<std::size_t>(end - line));
+            out += end - line;
+            break;
         }
-        ptrHd += std::sprintf(ptrHd, "  |");
-        for (std::size_t i = 0; i < bytesCurLine; i++) {
-            if (std::isprint(static_cast<int>(ptrLine[i])) != 0) { ptrHd += std::sprintf(ptrHd, "%c", ptrLine[i]); }
-            else {
-                ptrHd += std::sprintf(ptrHd, ".");
+        case Binary::DumpKind::hexdump:
+            // format: field[length]
+            //  ADDR[2+2*sizeof(void*)]+"   "+DATA_HEX[8*3]+" "+DATA_HEX[8*3]+"  |"+DATA_CHAR[8]+"|"
+            out    = appendAddress(out, line);
+            *out++ = ' ';
+            for (std::size_t i = 0; i < dump.bytesPerLine; i++) {
+                if ((i & 7) == 0) { *out++ = ' '; }
+                if (i < count) {
+                    *out++ = ' ';
+                    out    = appendHex(out, line[i]);
+                }
+                else {
+                    std::memcpy(out, "   ", 3);
+                    out += 3;
+                }
             }
-        }
-        ptrHd += std::sprintf(ptrHd, "|");
+            std::memcpy(out, "  |", 3);
+            out += 3;
+            for (std::size_t i = 0; i < count; i++) {
+                *out++ = std::isprint(static_cast<int>(line[i])) != 0 ? static_cast<char>(line[i]) : '.';
+            }
+            *out++ = '|';
+            break;
+    }
 
-        LOGGER_LOG_HELPER_IMPL(logger, level, "%s", &hdBuffer[0]);
-        buff += bytesCurLine;
-        len -= bytesCurLine;
-    } while (len != 0);
+    dump.data += count;
+    dump.length -= count;
+    return out;
+}
+
+#    if !LOGGER_USE_BINARY_FORMAT
+//! FormatFunc rendering as many whole lines of a dump as the buffer can take, each with its own prefix.
+std::size_t renderLines(char* buffer, std::size_t size, void* context)
+{
+    auto&             dump     = *static_cast<Dump*>(context);
+    const std::size_t lineRoom = dump.prefixLength + s_maxLineLength + 2;
+    assert(lineRoom < size && "Tag too long to dump a buffer");
+
+    char* out = buffer;
+    do {
+        std::memcpy(out, dump.prefix, dump.prefixLength);
+        out = renderLine(out + dump.prefixLength, dump);
+        std::memcpy(out, "\r\n", 2);
+        out += 2;
+    } while (dump.length != 0 && size - static_cast<std::size_t>(out - buffer) > lineRoom);
+    return static_cast<std::size_t>(out - buffer);
+}
+#    endif
+#endif
+
+#if LOGGER_USE_BINARY_BUFFER_DUMPS
+//! FormatFunc encoding as many whole lines of a dump as the buffer can take in a blob record.
+std::size_t encodeBlob(char* buffer, std::size_t size, void* context)
+{
+    auto&       dump     = *static_cast<Dump*>(context);
+    // Keep the chunks to whole lines, so that the host renders the same lines as the device would.
+    std::size_t capacity = Binary::Encoder::blobCapacity(size - 1, dump.tag);
+    capacity -= capacity % dump.bytesPerLine;
+    assert(capacity != 0 && "Tag too long to dump a buffer");
+
+    const auto      length = static_cast<std::uint16_t>(std::min(dump.length, capacity));
+    Binary::Encoder encoder {buffer, size - 1};
+    encoder.blob(dump.level,
+                 dump.timestamp,
+                 dump.kind,
+                 reinterpret_cast<std::uintptr_t>(dump.data),
+                 dump.tag,
+                 dump.data,
+                 length);
+    dump.data += length;
+    dump.length -= length;
+    return encoder.finish();
+}
+#endif
+}    // namespace
+
+void Logger::writeDump(LoggerView logger, Level level, Binary::DumpKind kind, const std::uint8_t* buff, std::size_t len)
+{
+    static_assert(s_bytesPerLine <= 16, "s_maxLineLength is sized for 16 bytes per line");
+#if LOGGER_USE_BINARY_FORMAT && !LOGGER_USE_BINARY_BUFFER_DUMPS
+    // Every line is a message of its own, counted by writeBinary.
+    if (!logger.shouldLog(level)) { return; }
+#else
+    if (!logger.admit(level)) { return; }
+#endif
+    if (len == 0 || buff == nullptr) { return; }
+
+    Dump dump {.kind = kind, .data = buff, .length = len, .bytesPerLine = s_bytesPerLine};
+#if LOGGER_USE_BINARY_BUFFER_DUMPS
+    dump.level     = level;
+    dump.timestamp = now();
+    dump.tag       = logger.tag;
+    do {
+        dispatch(logger, level, &encodeBlob, &dump);
+    } while (dump.length != 0);
+#elif LOGGER_USE_BINARY_FORMAT
+    // A binary record holds a single line.
+    do {
+        char line[s_maxLineLength + 1];
+        *renderLine(&line[0], dump) = '\0';
+        LOGGER_LOG_HELPER_IMPL(logger, level, "%s", &line[0]);
+    } while (dump.length != 0);
+#else
+    // Every line gets the usual prefix, but as many lines as possible go in a single message.
+    char prefix[64];
+    dump.prefix       = &prefix[0];
+    dump.prefixLength = std::min(Printf::format(&prefix[0],
+                                                sizeof(prefix),
+                                                "%c (%05lu) [%s] ",
+                                                levelToChar(level),
+                                                static_cast<unsigned long>(getTime()),
+                                                LOGGER_LOG_HELPER_IMPL_TAG_GETTER(logger)),
+                                 sizeof(prefix) - 1);
+    do {
+        dispatch(logger, level, &renderLines, &dump);
+    } while (dump.length != 0);
+#endif
 }
 
 }    // namespace Logging
@@ -17,6 +17,8 @@
 #ifndef VENDOR_LOGGING_LOGGER_H
 #define VENDOR_LOGGING_LOGGER_H
 
+#include <algorithm>
+#include <atomic>
 #include <cstdarg>
 #include <cstdint>
 #include <memory>
@@ -25,75 +27,402 @@
 #include <unordered_map>
 #include <vector>
 
+#include "binary_format.h"
+#include "config.h"
+#include "format.h"
 #include "level.h"
 #include "sink.h"
+#include "static_containers.h"
+#include "stats.h"
 
-// TODO the whole sink thing begs for dangling pointers to happen when a sink or a logger gets removed...
 namespace Logging {
+//! Whether the calls of that level are compiled in, see LOGGER_COMPILE_LEVEL.
+constexpr bool isLevelCompiledIn(Level level)
+{
+    return level <= LOGGER_COMPILE_LEVEL;
+}
+
+/**
+ * The configuration of the loggers (levels and sinks) is an immutable snapshot, replaced as a whole by the
+ * configuration functions. Log calls read it in a ReadGuard scope, without taking any lock. A replaced snapshot, and
+ * the sinks it alone referenced, are only destroyed once every log call that could still be using them has returned.
+ *
+ * The configuration functions must not be called concurrently with each other, nor from an interrupt or a sink. They
+ * allocate the new snapshot on the heap (or alternate between two static ones with LOGGER_STATIC_CONFIG), and may wait
+ * for the log calls in progress to return.
+ */
 class Logger {
+public:
+#if LOGGER_STATIC_CONFIG
+    using SinkList = StaticVector<Sink*, LOGGER_MAX_SINKS>;
+#else
+    using SinkList = std::vector<Sink*>;
+#endif
+
+private:
+#if LOGGER_STATIC_CONFIG
+    template<typename Key, typename Value>
+    using Map = StaticMap<Key, Value, LOGGER_MAX_LOGGERS>;
+#else
+    template<typename Key, typename Value>
+    using Map = std::unordered_map<Key, Value>;
+#endif
+
     struct LoggerInstance {
-        std::optional<Level>                              level = std::nullopt;
-        std::optional<std::vector<std::unique_ptr<Sink>>> sinks = std::nullopt;
+        std::optional<Level>    level = std::nullopt;
+        std::optional<SinkList> sinks = std::nullopt;
+        LoggerStats*            stats = nullptr;
+    };
+
+    //! Snapshot of the configuration, never modified once published.
+    struct Config {
+        std::uint32_t                         generation  = 1;
+        Level                                 globalLevel = s_defaultLevel;
+        SinkList                              globalSinks = {};
+        Map<std::string_view, LoggerInstance> loggers     = {};
     };
 
 public:
+    /**
+     * Logger resolved from a snapshot of the configuration. Only valid within the ReadGuard scope it was obtained in.
+     */
     struct LoggerView {
-        std::string_view                    tag;
-        Level*                              level = &s_globalLevel;
-        std::vector<std::unique_ptr<Sink>>* sinks = &s_globalSinks;
+        std::string_view          tag;
+        Level                     level = s_defaultLevel;
+        const SinkList*           sinks = &s_noSinks;
+        //! Shared by every tag without a level or sinks of its own.
+        LoggerStats*              stats = &s_globalStats;
+
+        //! Whether the logger takes that level and at least one of its sinks wants it.
+        bool shouldLog(Level desiredLevel) const { return desiredLevel <= level && isWantedBySinks(desiredLevel); }
+
+        //! Same as shouldLog, also counting the call in the logger's statistics.
+        bool admit(Level desiredLevel) const
+        {
+            if (!shouldLog(desiredLevel)) {
+                stats->filtered.add();
+                return false;
+            }
+            stats->count(desiredLevel);
+            return true;
+        }
+
+        bool isWantedBySinks(Level desiredLevel) const
+        {
+            return std::ranges::any_of(*sinks, [desiredLevel](const auto& sink) { return sink->accepts(desiredLevel); });
+        }
+    };
 
-        bool shouldLog(Level desiredLevel) const { return desiredLevel <= *level; }
+    /**
+     * Read-side critical section: the snapshot of the configuration current when the guard was created, and every
+     * LoggerView obtained from it, stay valid until the guard is destroyed. Guards can be nested, and used from
+     * interrupts.
+     *
+     * A guard costs two atomic increments, the readers are counted in two halves so that a configuration change only
+     * waits for the log calls that started before it.
+     */
+    class ReadGuard {
+        std::uint32_t m_half;
+
+    public:
+        ReadGuard() : m_half(s_epoch.load() & 1) { s_readers[m_half].fetch_add(1); }
+        ~ReadGuard() { s_readers[m_half].fetch_sub(1); }
+        ReadGuard(const ReadGuard&)            = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+    };
+
+    /**
+     * Logger view cached by a log call site, so that a filtered-out call doesn't have to look the logger up.
+     *
+     * The cache is refreshed whenever the configuration of the loggers changes. It belongs to the first tag the call
+     * site is used with: a call site shared by several tags (e.g. in a helper taking the tag as a parameter) looks the
+     * other tags up on every call instead.
+     *
+     * Several tasks can use the same call site, the cache is a seqlock: a refresh marks it busy, writes the fields,
+     * then publishes the generation they belong to. Readers only use fields read between two equal generations.
+     */
+    class CallSite {
+        //! While a task refreshes the cache, readers ignore it.
+        static constexpr std::uint32_t s_busy = UINT32_MAX;
+
+        //! Consistent copy of the cache.
+        struct Entry {
+            std::uint32_t   generation;
+            const char*     tag;
+            std::size_t     tagSize;
+            Level           level;
+            const SinkList* sinks;
+            LoggerStats*    stats;
+
+            [[nodiscard]] bool isFor(std::string_view other) const
+            {
+                return tag == other.data() && tagSize == other.size();
+            }
+        };
+
+        // Generations start at 1, the first call always refreshes.
+        std::atomic<std::uint32_t>   m_generation = 0;
+        std::atomic<const char*>     m_tag        = nullptr;
+        std::atomic<std::size_t>     m_tagSize    = 0;
+        std::atomic<Level>           m_level      = Level::none;
+        std::atomic<const SinkList*> m_sinks      = nullptr;
+        std::atomic<LoggerStats*>    m_stats      = nullptr;
+
+    public:
+        // User-provided, a defaulted constructor isn't usable by the constinit statics of the macros before the end of
+        // the class.
+        constexpr CallSite() {}    // NOLINT(*-use-equals-default)
+
+        /**
+         * Rejects the call from the cache, without needing a ReadGuard: the statistics are the only thing it touches,
+         * and they are never freed.
+         * @return True if the cache is current and the logger doesn't take that level. False if shouldLog must decide.
+         */
+        bool isFilteredOut(std::string_view tag, Level level) const
+        {
+            Entry entry;
+            if (!load(entry) || level <= entry.level || !entry.isFor(tag) ||
+                entry.generation != s_generation.load(std::memory_order_relaxed)) {
+                return false;
+            }
+            entry.stats->filtered.add();
+            return true;
+        }
+
+        /**
+         * Must be called in a ReadGuard scope.
+         * @param tag Tag of the call.
+         * @param level Level of the call.
+         * @param view Receives the view of the logger, only valid if true is returned.
+         * @return True if the message should be logged.
+         */
+        bool shouldLog(std::string_view tag, Level level, LoggerView& view)
+        {
+            const Config& config = currentConfig();
+            // The generation tells whether the cached view points into the snapshot that the guard protects.
+            Entry entry;
+            if (load(entry) && entry.generation == config.generation && entry.isFor(tag)) {
+                view = {.tag = tag, .level = entry.level, .sinks = entry.sinks, .stats = entry.stats};
+            }
+            else {
+                view = getLogger(config, tag);
+                refresh(view, config.generation);
+            }
+            // The sinks' levels aren't cached, they can be changed without going through the Logger.
+            if (!view.shouldLog(level)) {
+                view.stats->filtered.add();
+                return false;
+            }
+            return true;
+        }
+
+    private:
+        //! @return False if the cache is being refreshed.
+        bool load(Entry& entry) const
+        {
+            entry.generation = m_generation.load(std::memory_order_acquire);
+            if (entry.generation == s_busy) { return false; }
+            entry.tag     = m_tag.load(std::memory_order_relaxed);
+            entry.tagSize = m_tagSize.load(std::memory_order_relaxed);
+            entry.level   = m_level.load(std::memory_order_relaxed);
+            entry.sinks   = m_sinks.load(std::memory_order_relaxed);
+            entry.stats   = m_stats.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return m_generation.load(std::memory_order_relaxed) == entry.generation;
+        }
+
+        //! Caches the view, unless the call site belongs to another tag or another task is refreshing it.
+        void refresh(const LoggerView& view, std::uint32_t generation);
     };
 
     using GetTimeFunc = std::uint32_t (*)();
+    //! Raw timestamp of a message, see setClock.
+    using ClockFunc   = std::uint64_t (*)();
+    //! Formats a message into a buffer of `size` bytes. Returns the length of the whole message, like snprintf.
+    using FormatFunc = std::size_t (*)(char* buffer, std::size_t size, void* context);
+
+#if LOGGER_STATIC_CONFIG
+    using SinkSnapshots = StaticVector<SinkStats::Snapshot, LOGGER_MAX_SINKS>;
+#else
+    using SinkSnapshots = std::vector<SinkStats::Snapshot>;
+#endif
+
+    //! Statistics of a logger, see snapshotStats.
+    struct LoggerSnapshot {
+        std::string_view      tag;      //!< Empty for the global logger.
+        LoggerStats::Snapshot stats;
+        SinkSnapshots         sinks;    //!< Only the logger's own sinks, in the order they were added.
+    };
 
-private:
-    //! print number of bytes per line for writeHexArray and writeCharArray
-    static constexpr std::size_t                     s_bytesPerLine = 16;
-    static constexpr Level                           s_defaultLevel = Level::all;
-    inline static Level                              s_globalLevel  = s_defaultLevel;
-    inline static std::vector<std::unique_ptr<Sink>> s_globalSinks  = {};
+#if LOGGER_STATIC_CONFIG
+    using LoggerSnapshots = StaticVector<LoggerSnapshot, LOGGER_MAX_LOGGERS + 1>;
+#else
+    using LoggerSnapshots = std::vector<LoggerSnapshot>;
+#endif
 
-    inline static std::unordered_map<std::string_view, LoggerInstance> s_loggers = {};
-    inline static GetTimeFunc                                          s_getTime = [] -> std::uint32_t { return 0; };
+private:
+    //! print number of bytes per line for writeHexArray, writeCharArray and writeHexdumpArray
+    static constexpr std::size_t s_bytesPerLine = 16;
+    //! Maximum length of a formatted message, in bytes, null terminator included.
+    static constexpr std::size_t s_maxLength = 512;
+    //! Maximum size of a frame in binary mode, in bytes.
+    static constexpr std::size_t s_binaryMaxLength = 128;
+    static constexpr Level       s_defaultLevel    = Level::all;
+
+    inline static const SinkList s_noSinks     = {};
+    inline static LoggerStats    s_globalStats = {};
+    //! Statistics of the loggers by tag. Kept when a logger is removed, so that a log call can still count into them.
+    inline static Map<std::string_view, LoggerStats> s_loggerStats = {};
+
+    static Config s_defaultConfig;
+#if LOGGER_STATIC_CONFIG
+    //! The two snapshots take turns: the previous one is free once update() returns.
+    static Config s_spareConfig;
+#else
+    //! Sinks created by addSink, destroyed once no snapshot references them anymore.
+    inline static std::vector<std::unique_ptr<Sink>> s_ownedSinks  = {};
+    inline static std::unique_ptr<Config>            s_ownedConfig = nullptr;    //!< The current snapshot, once changed.
+#endif
+    inline static std::atomic<const Config*>  s_config        = &s_defaultConfig;
+    //! Generation of the current snapshot, for the call sites' caches.
+    inline static std::atomic<std::uint32_t>  s_generation    = 1;
+    //! Half of s_readers that new ReadGuards join.
+    inline static std::atomic<std::uint32_t>  s_epoch         = 0;
+    inline static std::atomic<std::uint32_t>  s_readers[2]    = {};
+
+    inline static GetTimeFunc   s_getTime             = [] -> std::uint32_t { return 0; };
+    inline static ClockFunc     s_clock               = [] -> std::uint64_t { return s_getTime(); };
+    inline static std::uint64_t s_ticksPerSecond      = 1000;
+    inline static std::uint64_t s_ticksPerMillisecond = 1;
 
 public:
-    static void          setGetTime(GetTimeFunc getTime);
-    static std::uint32_t getTime() { return s_getTime(); }
+    //! Sets a millisecond clock, e.g. HAL_GetTick. Replaces the clock set with setClock.
+    static void setGetTime(GetTimeFunc getTime);
+    /**
+     * Sets a high-resolution clock, e.g. DwtClock or PosixClock, read once per message.
+     *
+     * Binary records carry its raw value, which the host decoder converts, while the text prefix shows it in
+     * milliseconds.
+     */
+    static void          setClock(ClockFunc clock, std::uint64_t ticksPerSecond);
+    static std::uint64_t now() { return s_clock(); }
+    static std::uint64_t getTicksPerSecond() { return s_ticksPerSecond; }
+    //! Time in milliseconds, as shown in the prefix of the text messages.
+    static std::uint32_t getTime()
+    {
+        // Skip the 64-bit division for millisecond clocks.
+        const std::uint64_t ticks = now();
+        return static_cast<std::uint32_t>(s_ticksPerMillisecond == 1 ? ticks : ticks / s_ticksPerMillisecond);
+    }
+
+    //! The view is only valid while the guard lives.
+    static LoggerView getLogger(const ReadGuard& /*guard*/, std::string_view tag)
+    {
+        return getLogger(currentConfig(), tag);
+    }
 
-    static LoggerView getLogger(std::string_view tag);
+    /**
+     * Same as getLogger(guard, tag), for the code written before the configuration could change at runtime. Must be
+     * called in a ReadGuard scope, the view is only valid within it.
+     */
+    [[deprecated("Create a ReadGuard and use getLogger(guard, tag)")]] static LoggerView getLogger(std::string_view tag)
+    {
+        return getLogger(currentConfig(), tag);
+    }
 
-    // TODO: This should allow us to add an already existing sink...
+#if !LOGGER_STATIC_CONFIG
     template<typename T, typename... Args>
         requires std::derived_from<T, Sink> && std::constructible_from<T, Args...>
     static T* addSink(Args&&... args)
     {
-        s_globalSinks.push_back(std::make_unique<T>(std::forward<Args>(args)...));
-        return static_cast<T*>(s_globalSinks.back().get());
+        return static_cast<T*>(adoptSink(std::nullopt, std::make_unique<T>(std::forward<Args>(args)...)));
     }
-    static void  clearSinks() { s_globalSinks.clear(); }
-    static void  setLevel(Level level) { s_globalLevel = level; }
-    static Level getLevel() { return s_globalLevel; }
-    static void  clearLevel() { s_globalLevel = s_defaultLevel; }
+#endif
+    /**
+     * Adds a sink owned by the caller, e.g. a static one or one shared with another logger.
+     *
+     * @attention The sink must outlive the Logger's use of it: after clearSinks returns, it is not used anymore.
+     * @note With LOGGER_STATIC_CONFIG, a sink that doesn't fit in the logger is ignored (an assert fails first).
+     */
+    static void addSink(Sink& sink);
+    static void clearSinks();
+    static void setLevel(Level level);
+    static Level getLevel() { return currentConfig().globalLevel; }
+    static void  clearLevel();
 
+#if !LOGGER_STATIC_CONFIG
     template<typename T, typename... Args>
         requires std::derived_from<T, Sink> && std::constructible_from<T, Args...>
     static T* addSink(std::string_view tag, Args&&... args)
     {
-        auto& sink = s_loggers[tag];
-        if (!sink.sinks) { sink.sinks = std::vector<std::unique_ptr<Sink>> {}; }
-        sink.sinks->push_back(std::make_unique<T>(std::forward<Args>(args)...));
-        return static_cast<T*>(sink.sinks->back().get());
+        return static_cast<T*>(adoptSink(tag, std::make_unique<T>(std::forward<Args>(args)...)));
     }
-
+#endif
+    //! Same as addSink(Sink&), for a single logger.
+    static void  addSink(std::string_view tag, Sink& sink);
     static void  clearSinks(std::string_view tag);
     static void  setLevel(std::string_view tag, Level level);
     static Level getLevel(std::string_view tag);
     static void  clearLevel(std::string_view tag);
 
+    /**
+     * Reads the statistics of the global logger, then of every logger that has a level or sinks of its own. The other
+     * tags are counted with the global logger.
+     *
+     * The counters are relaxed atomics, this can be called while logging goes on. Like the other configuration
+     * functions, it must not race with them.
+     */
+    static LoggerSnapshots snapshotStats();
+
     static void write(LoggerView logger, Level level, const char* fmt, ...);
     static void vWrite(LoggerView logger, Level level, const char* fmt, va_list args);
 
+    /**
+     * @brief Log a message with a std::format-style format string, checked against its arguments at compile time.
+     *
+     * @param  logger view of the logger and its sinks
+     * @param  level level of the log
+     * @param  args arguments of the format string
+     */
+    template<Format::FixedString Fmt, typename... Args>
+    static void writeFormatted(LoggerView logger, Level level, const Args&... args)
+    {
+        if (!logger.admit(level)) { return; }
+        auto format = [&](char* buffer, std::size_t size) { return Format::formatTo<Fmt>(buffer, size, args...); };
+        dispatch(
+          logger,
+          level,
+          [](char* buffer, std::size_t size, void* context) {
+              return (*static_cast<decltype(format)*>(context))(buffer, size);
+          },
+          &format);
+    }
+
+    /**
+     * @brief Log a message in binary form, to be formatted on the host.
+     *
+     * @param  logger view of the logger and its sinks
+     * @param  level level of the log
+     * @param  formatId ID of the format string, obtained with LOGGER_BINARY_FORMAT_ID
+     * @param  args arguments of the format string, sent as-is
+     * @tparam Type message for printf-style format strings, formatMessage for std::format-style ones
+     */
+    template<Binary::RecordType Type = Binary::RecordType::message, typename... Args>
+    static void writeBinary(LoggerView logger, Level level, std::uint32_t formatId, const Args&... args)
+    {
+        if (!logger.admit(level)) { return; }
+        char            buffer[s_binaryMaxLength];
+        Binary::Encoder encoder {&buffer[0], sizeof(buffer)};
+        encoder.message(Type, level, now(), formatId, logger.tag, args...);
+        const std::size_t length = encoder.finish();
+        if (length == 0) {
+            // Too many arguments, even with the strings truncated.
+            dropTooLong(logger, level);
+            return;
+        }
+        writeRaw(logger, level, &buffer[0], length);
+    }
+
     /**
      * @brief Log a buffer of hex bytes at specified level, separated into 16 bytes each line.
      *
@@ -132,6 +461,54 @@ public:
      * @param  len length of buffer in bytes
      */
     static void writeHexdumpArray(LoggerView logger, Level level, const std::uint8_t* buff, std::size_t len);
+
+private:
+    //! Sends a record to the sinks that want its level. Empty records are ignored.
+    static void writeRaw(LoggerView logger, Level level, const char* data, std::size_t length);
+    //! Counts a record that couldn't be encoded as dropped by every sink that wanted it.
+    static void dropTooLong(LoggerView logger, Level level);
+    //! Formats a message straight into the buffer of the sink if only one wants it and can lend it, and hands it to
+    //! every sink.
+    static void dispatch(LoggerView logger, Level level, FormatFunc format, void* context);
+    //! Fallback of dispatch for when the message can't be formatted in place. Kept out of line so that its buffer only
+    //! takes stack space when it is actually used.
+    [[gnu::noinline]] static void writeBuffered(LoggerView logger, Level level, FormatFunc format, void* context);
+    static std::size_t            clampLength(std::size_t length);
+    static void                   countDelivery(Sink& sink, std::size_t length)
+    {
+        SinkStats& stats = sink.stats();
+        stats.messages.add();
+        stats.bytes.add(static_cast<std::uint32_t>(length));
+    }
+    //! Tells the host decoder the frequency of the timestamps, in the binary modes.
+    static void writeClockInfo(Sink& sink);
+    static void writeClockInfo();
+    //! Renders a whole dump with a lookup table, packing as many lines as possible in each message, or sends it as blob
+    //! records if LOGGER_USE_BINARY_BUFFER_DUMPS is set.
+    static void writeDump(LoggerView logger, Level level, Binary::DumpKind kind, const std::uint8_t* buff, std::size_t len);
+
+    static const Config& currentConfig() { return *s_config.load(); }
+    static LoggerView    getLogger(const Config& config, std::string_view tag);
+
+    /**
+     * Gets the logger of a tag in a snapshot being built, creating it if needed.
+     * @return nullptr if the tag is new and there's no room left for it, with LOGGER_STATIC_CONFIG.
+     */
+    static LoggerInstance* loggerInstance(Config& config, std::string_view tag);
+    static LoggerStats*    loggerStats(std::string_view tag);
+    static void            addSink(SinkList& sinks, Sink& sink);
+#if !LOGGER_STATIC_CONFIG
+    static Sink* adoptSink(std::optional<std::string_view> tag, std::unique_ptr<Sink> sink);
+    static void  releaseUnusedSinks();
+#endif
+    /**
+     * Copies the current snapshot, lets `change` modify the copy and publishes it. Then destroys the previous snapshot
+     * and the sinks that aren't used anymore, once no log call uses them.
+     */
+    template<typename F>
+    static void update(F&& change);
+    //! Waits for every ReadGuard created before the call to be destroyed.
+    static void synchronize();
 };
 }    // namespace Logging
 
@@ -150,26 +527,89 @@ public:
 //  null-terminated string_views
 #define LOGGER_LOG_HELPER_IMPL_TAG_GETTER(logger) (logger).tag.data()    // NOLINT(*-suspicious-stringview-data-usage)
 
-#define LOGGER_LOG_HELPER_IMPL(logger, level, msg, ...)                                                                \
+#if LOGGER_USE_BINARY_FORMAT
+// The level, timestamp and tag are fields of the record, the host decoder rebuilds the usual prefix from them.
+#    define LOGGER_LOG_HELPER_IMPL(logger, level, msg, ...)                                                            \
+        do {                                                                                                           \
+            LOGGER_HELPER_MSG_IS_STRING_LITERAL(msg);                                                                  \
+            ::Logging::Logger::writeBinary(                                                                            \
+              logger, level, LOGGER_BINARY_FORMAT_ID(msg) __VA_OPT__(, ) __VA_ARGS__);                                 \
+        } while (0)
+#else
+#    define LOGGER_LOG_HELPER_IMPL(logger, level, msg, ...)                                                            \
+        do {                                                                                                           \
+            LOGGER_HELPER_MSG_IS_STRING_LITERAL(msg);                                                                  \
+            ::Logging::Logger::write(logger,                                                                           \
+                                     level,                                                                            \
+                                     "%c (%05lu) [%s] " msg "\r\n",                                                    \
+                                     ::Logging::levelToChar(level),                                                    \
+                                     static_cast<unsigned long>(::Logging::Logger::getTime()),                         \
+                                     LOGGER_LOG_HELPER_IMPL_TAG_GETTER(logger) __VA_OPT__(, ) __VA_ARGS__);            \
+        } while (0)
+#endif
+
+#if LOGGER_USE_BINARY_FORMAT
+#    define LOGGER_LOG_HELPER_IMPL_F(logger, level, msg, ...)                                                          \
+        do {                                                                                                           \
+            ::Logging::Format::check<msg>(__VA_ARGS__);                                                                \
+            ::Logging::Logger::writeBinary<::Logging::Binary::RecordType::formatMessage>(                              \
+              logger, level, LOGGER_BINARY_FORMAT_ID(msg) __VA_OPT__(, ) __VA_ARGS__);                                 \
+        } while (0)
+#else
+#    define LOGGER_LOG_HELPER_IMPL_F(logger, level, msg, ...)                                                          \
+        do {                                                                                                           \
+            ::Logging::Logger::writeFormatted<"{:c} ({:05}) [{}] " msg "\r\n">(logger,                                 \
+                                                                             level,                                    \
+                                                                             ::Logging::levelToChar(level),            \
+                                                                             ::Logging::Logger::getTime(),             \
+                                                                             (logger).tag __VA_OPT__(, ) __VA_ARGS__); \
+        } while (0)
+#endif
+
+// The level must be a constant expression, calls above LOGGER_COMPILE_LEVEL are discarded entirely.
+// Each call site caches its logger, a filtered-out call only costs a couple of compares.
+#define LOGGER_LOG_HELPER(tag, level, msg, ...)                                                                        \
     do {                                                                                                               \
-        LOGGER_HELPER_MSG_IS_STRING_LITERAL(msg);                                                                      \
-        ::Logging::Logger::write(logger,                                                                               \
-                                 level,                                                                                \
-                                 "%c (%05lu) [%s] " msg "\r\n",                                                        \
-                                 ::Logging::levelToChar(level),                                                        \
-                                 ::Logging::Logger::getTime(),                                                         \
-                                 LOGGER_LOG_HELPER_IMPL_TAG_GETTER(logger) __VA_OPT__(, ) __VA_ARGS__);                \
+        if constexpr (::Logging::isLevelCompiledIn(level)) {                                                           \
+            static constinit ::Logging::Logger::CallSite s_loggerCallSite;                                             \
+            if (!s_loggerCallSite.isFilteredOut(tag, level)) {                                                         \
+                ::Logging::Logger::ReadGuard  loggerGuard;                                                             \
+                ::Logging::Logger::LoggerView loggerView;                                                              \
+                if (s_loggerCallSite.shouldLog(tag, level, loggerView)) {                                              \
+                    LOGGER_LOG_HELPER_IMPL(loggerView, level, msg, __VA_ARGS__);                                       \
+                }                                                                                                      \
+            }                                                                                                          \
+        }                                                                                                              \
     } while (0)
 
-#define LOGGER_LOG_HELPER(tag, level, msg, ...)                                                                        \
-    LOGGER_LOG_HELPER_IMPL(::Logging::Logger::getLogger(tag), level, msg, __VA_ARGS__)
-
 #define LOGT(tag, msg, ...) LOGGER_LOG_HELPER(tag, ::Logging::Level::trace, msg __VA_OPT__(, ) __VA_ARGS__)
 #define LOGD(tag, msg, ...) LOGGER_LOG_HELPER(tag, ::Logging::Level::debug, msg __VA_OPT__(, ) __VA_ARGS__)
 #define LOGI(tag, msg, ...) LOGGER_LOG_HELPER(tag, ::Logging::Level::info, msg __VA_OPT__(, ) __VA_ARGS__)
 #define LOGW(tag, msg, ...) LOGGER_LOG_HELPER(tag, ::Logging::Level::warning, msg __VA_OPT__(, ) __VA_ARGS__)
 #define LOGE(tag, msg, ...) LOGGER_LOG_HELPER(tag, ::Logging::Level::error, msg __VA_OPT__(, ) __VA_ARGS__)
 
+// Same as LOGGER_LOG_HELPER, with a std::format-style format string, e.g. `LOGI_F(tag, "x={} y={:#x}", x, y)`.
+// The format string is parsed at compile time, a mismatch with the arguments is a compilation error.
+#define LOGGER_LOG_HELPER_F(tag, level, msg, ...)                                                                      \
+    do {                                                                                                               \
+        if constexpr (::Logging::isLevelCompiledIn(level)) {                                                           \
+            static constinit ::Logging::Logger::CallSite s_loggerCallSite;                                             \
+            if (!s_loggerCallSite.isFilteredOut(tag, level)) {                                                         \
+                ::Logging::Logger::ReadGuard  loggerGuard;                                                             \
+                ::Logging::Logger::LoggerView loggerView;                                                              \
+                if (s_loggerCallSite.shouldLog(tag, level, loggerView)) {                                              \
+                    LOGGER_LOG_HELPER_IMPL_F(loggerView, level, msg, __VA_ARGS__);                                     \
+                }                                                                                                      \
+            }                                                                                                          \
+        }                                                                                                              \
+    } while (0)
+
+#define LOGT_F(tag, msg, ...) LOGGER_LOG_HELPER_F(tag, ::Logging::Level::trace, msg __VA_OPT__(, ) __VA_ARGS__)
+#define LOGD_F(tag, msg, ...) LOGGER_LOG_HELPER_F(tag, ::Logging::Level::debug, msg __VA_OPT__(, ) __VA_ARGS__)
+#define LOGI_F(tag, msg, ...) LOGGER_LOG_HELPER_F(tag, ::Logging::Level::info, msg __VA_OPT__(, ) __VA_ARGS__)
+#define LOGW_F(tag, msg, ...) LOGGER_LOG_HELPER_F(tag, ::Logging::Level::warning, msg __VA_OPT__(, ) __VA_ARGS__)
+#define LOGE_F(tag, msg, ...) LOGGER_LOG_HELPER_F(tag, ::Logging::Level::error, msg __VA_OPT__(, ) __VA_ARGS__)
+
 #define ROOT_LOGGER_TAG "ROOT"
 
 #define ROOT_LOGT(msg, ...) LOGT(ROOT_LOGGER_TAG, msg __VA_OPT__(, ) __VA_ARGS__)
@@ -178,8 +618,26 @@ public:
 #define ROOT_LOGW(msg, ...) LOGW(ROOT_LOGGER_TAG, msg __VA_OPT__(, ) __VA_ARGS__)
 #define ROOT_LOGE(msg, ...) LOGE(ROOT_LOGGER_TAG, msg __VA_OPT__(, ) __VA_ARGS__)
 
+#define ROOT_LOGT_F(msg, ...) LOGT_F(ROOT_LOGGER_TAG, msg __VA_OPT__(, ) __VA_ARGS__)
+#define ROOT_LOGD_F(msg, ...) LOGD_F(ROOT_LOGGER_TAG, msg __VA_OPT__(, ) __VA_ARGS__)
+#define ROOT_LOGI_F(msg, ...) LOGI_F(ROOT_LOGGER_TAG, msg __VA_OPT__(, ) __VA_ARGS__)
+#define ROOT_LOGW_F(msg, ...) LOGW_F(ROOT_LOGGER_TAG, msg __VA_OPT__(, ) __VA_ARGS__)
+#define ROOT_LOGE_F(msg, ...) LOGE_F(ROOT_LOGGER_TAG, msg __VA_OPT__(, ) __VA_ARGS__)
+
+// Same as LOGGER_LOG_HELPER, the level must be a constant expression.
 #define LOGGER_LOG_BUFFER_DUMP_HELPER(kind, tag, level, buff, len)                                                     \
-    ::Logging::Logger::write##kind##Array(::Logging::Logger::getLogger(tag), level, buff, len)
+    do {                                                                                                               \
+        if constexpr (::Logging::isLevelCompiledIn(level)) {                                                           \
+            static constinit ::Logging::Logger::CallSite s_loggerCallSite;                                             \
+            if (!s_loggerCallSite.isFilteredOut(tag, level)) {                                                         \
+                ::Logging::Logger::ReadGuard  loggerGuard;                                                             \
+                ::Logging::Logger::LoggerView loggerView;                                                              \
+                if (s_loggerCallSite.shouldLog(tag, level, loggerView)) {                                              \
+                    ::Logging::Logger::write##kind##Array(loggerView, level, buff, len);                               \
+                }                                                                                                      \
+            }                                                                                                          \
+        }                                                                                                              \
+    } while (0)
 
 #define LOG_BUFFER_HEX_LEVEL(tag, level, buffer, len)  LOGGER_LOG_BUFFER_DUMP_HELPER(Hex, tag, level, buffer, len)
 #define LOG_BUFFER_CHAR_LEVEL(tag, level, buffer, len) LOGGER_LOG_BUFFER_DUMP_HELPER(Char, tag, level, buffer, len)
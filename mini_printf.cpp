@@ -0,0 +1,310 @@
+/**
+ * @file    mini_printf.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#include "mini_printf.h"
+
+#include "config.h"
+
+#if LOGGER_USE_LIBC_PRINTF
+#    include <cstdio>
+#else
+#    include "format.h"
+
+#    include <cstdint>
+#    include <cstring>
+#endif
+
+namespace Logging::Printf {
+#if LOGGER_USE_LIBC_PRINTF
+std::size_t vformat(char* buffer, std::size_t size, const char* fmt, va_list args)
+{
+    int length = vsnprintf(buffer, size, fmt, args);
+    return length < 0 ? 0 : static_cast<std::size_t>(length);
+}
+#else
+namespace {
+using Format::Spec;
+using Format::Detail::Writer;
+
+enum class Length : std::uint8_t {
+    none,
+    hh,
+    h,
+    l,
+    ll,
+    j,
+    z,
+    t,
+    L,
+};
+
+void writeInteger(Writer& out, const Spec& spec, std::uintmax_t magnitude, bool negative)
+{
+    // Longest precision honored, it is only meant for a few leading zeros.
+    static constexpr int s_maxPrecision = 32;
+
+    unsigned base = 10;
+    switch (spec.type) {
+        case 'o': base = 8; break;
+        case 'x':
+        case 'X':
+        case 'p': base = 16; break;
+        default: break;
+    }
+
+    // Sign, prefix, zeros of the precision and the digits of a 64-bit value in octal.
+    char        buffer[1 + 2 + s_maxPrecision + 22];
+    char*       end    = &buffer[sizeof(buffer)];
+    std::size_t digits = 0;
+    // A precision of 0 prints nothing for a value of 0.
+    if (magnitude > UINT32_MAX) { digits = Format::Detail::writeDigits(end, magnitude, base, spec.type == 'X'); }
+    else if (magnitude != 0 || spec.precision != 0) {
+        // Most values fit in 32 bits, where a 32-bit target doesn't need a library call for each division.
+        digits = Format::Detail::writeDigits(end, static_cast<std::uint32_t>(magnitude), base, spec.type == 'X');
+    }
+    char* begin = end - digits;
+
+    const std::size_t precision = static_cast<std::size_t>(std::min(spec.precision, s_maxPrecision));
+    while (spec.precision > 0 && static_cast<std::size_t>(end - begin) < precision) {
+        *--begin = '0';
+    }
+    if (spec.alternate) {
+        // Nothing was written for a value of 0 with a precision of 0, which still gets its 0.
+        if (base == 8 && (begin == end || *begin != '0')) { *--begin = '0'; }
+        else if (base == 16 && (magnitude != 0 || spec.type == 'p')) {
+            *--begin = spec.type == 'X' ? 'X' : 'x';
+            *--begin = '0';
+        }
+    }
+    if (negative) { *--begin = '-'; }
+    else if (spec.sign != '-' && spec.type != 'u' && base == 10) {
+        *--begin = spec.sign;
+    }
+
+    // The 0 flag is ignored when a precision is given.
+    Spec padding = spec;
+    padding.zeroPad &= spec.precision < 0;
+    const std::size_t prefix =
+      static_cast<std::size_t>(end - begin) - digits - (spec.precision > 0 ? precision - std::min(digits, precision) : 0);
+    Format::Detail::writePadded(out, padding, '>', begin, static_cast<std::size_t>(end - begin), prefix);
+}
+
+std::intmax_t signedArg(Length length, va_list& args)
+{
+    switch (length) {
+        case Length::hh: return static_cast<signed char>(va_arg(args, int));
+        case Length::h: return static_cast<short>(va_arg(args, int));
+        case Length::l: return va_arg(args, long);
+        case Length::ll: return va_arg(args, long long);
+        case Length::j: return va_arg(args, std::intmax_t);
+        case Length::z: return static_cast<std::intmax_t>(va_arg(args, std::size_t));
+        case Length::t: return va_arg(args, std::ptrdiff_t);
+        default: return va_arg(args, int);
+    }
+}
+
+std::uintmax_t unsignedArg(Length length, va_list& args)
+{
+    switch (length) {
+        case Length::hh: return static_cast<unsigned char>(va_arg(args, unsigned int));
+        case Length::h: return static_cast<unsigned short>(va_arg(args, unsigned int));
+        case Length::l: return va_arg(args, unsigned long);
+        case Length::ll: return va_arg(args, unsigned long long);
+        case Length::j: return va_arg(args, std::uintmax_t);
+        case Length::z: return va_arg(args, std::size_t);
+        case Length::t: return static_cast<std::uintmax_t>(va_arg(args, std::ptrdiff_t));
+        default: return va_arg(args, unsigned int);
+    }
+}
+
+std::size_t parseNumber(const char*& it)
+{
+    std::size_t value = 0;
+    while (*it >= '0' && *it <= '9') {
+        value = value * 10 + static_cast<std::size_t>(*it++ - '0');
+    }
+    return value;
+}
+
+Length parseLength(const char*& it)
+{
+    switch (*it) {
+        case 'h':
+            if (*++it != 'h') { return Length::h; }
+            it++;
+            return Length::hh;
+        case 'l':
+            if (*++it != 'l') { return Length::l; }
+            it++;
+            return Length::ll;
+        case 'j': it++; return Length::j;
+        case 'z': it++; return Length::z;
+        case 't': it++; return Length::t;
+        case 'L': it++; return Length::L;
+        default: return Length::none;
+    }
+}
+}    // namespace
+
+std::size_t vformat(char* buffer, std::size_t size, const char* fmt, va_list args)
+{
+    // Keep room for the null terminator.
+    Writer out {buffer, size != 0 ? size - 1 : 0};
+
+    // Work on a copy: a va_list parameter can't be passed by reference on every ABI.
+    va_list argList;
+    va_copy(argList, args);
+
+    const char* it = fmt;
+    while (*it != '\0') {
+        const char* literal = it;
+        while (*it != '\0' && *it != '%') {
+            it++;
+        }
+        out.write(literal, static_cast<std::size_t>(it - literal));
+        if (*it == '\0') { break; }
+
+        const char* conversion = it++;
+        Spec        spec;
+        for (;; it++) {
+            if (*it == '-') { spec.align = '<'; }
+            else if (*it == '+') {
+                spec.sign = '+';
+            }
+            else if (*it == ' ') {
+                spec.sign = spec.sign == '+' ? '+' : ' ';
+            }
+            else if (*it == '#') {
+                spec.alternate = true;
+            }
+            else if (*it == '0') {
+                spec.zeroPad = true;
+            }
+            else {
+                break;
+            }
+        }
+        if (*it == '*') {
+            it++;
+            int width = va_arg(argList, int);
+            if (width < 0) {
+                spec.align = '<';
+                width      = -width;
+            }
+            spec.width = static_cast<std::size_t>(width);
+        }
+        else {
+            spec.width = parseNumber(it);
+        }
+        if (*it == '.') {
+            it++;
+            if (*it == '*') {
+                it++;
+                spec.precision = va_arg(argList, int);
+            }
+            else {
+                spec.precision = static_cast<int>(parseNumber(it));
+            }
+        }
+        // The 0 flag doesn't apply when left-aligned.
+        spec.zeroPad &= spec.align != '<';
+        const Length length = parseLength(it);
+        spec.type           = *it;
+
+        switch (*it) {
+            case 'd':
+            case 'i': {
+                std::intmax_t value = signedArg(length, argList);
+                writeInteger(out,
+                             spec,
+                             value < 0 ? std::uintmax_t(0) - static_cast<std::uintmax_t>(value)
+                                       : static_cast<std::uintmax_t>(value),
+                             value < 0);
+                break;
+            }
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X': writeInteger(out, spec, unsignedArg(length, argList), false); break;
+            case 'c': {
+                const char c   = static_cast<char>(va_arg(argList, int));
+                spec.zeroPad   = false;
+                spec.precision = -1;
+                Format::Detail::writePadded(out, spec, '>', &c, 1);
+                break;
+            }
+            case 's': {
+                const char* str = va_arg(argList, const char*);
+                if (str == nullptr) { str = "(null)"; }
+                std::size_t strLength = 0;
+                if (spec.precision < 0) { strLength = std::strlen(str); }
+                else {
+                    const auto* end = static_cast<const char*>(
+                      std::memchr(str, '\0', static_cast<std::size_t>(spec.precision)));
+                    strLength = end != nullptr ? static_cast<std::size_t>(end - str)
+                                               : static_cast<std::size_t>(spec.precision);
+                }
+                spec.zeroPad = false;
+                Format::Detail::writePadded(out, spec, '>', str, strLength);
+                break;
+            }
+            case 'p': {
+                spec.alternate = true;
+                writeInteger(out, spec, reinterpret_cast<std::uintptr_t>(va_arg(argList, void*)), false);
+                break;
+            }
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A': {
+                const double value = length == Length::L ? static_cast<double>(va_arg(argList, long double))
+                                                         : va_arg(argList, double);
+                if (spec.type == 'g' || spec.type == 'a') { spec.type = 'e'; }
+                else if (spec.type == 'G' || spec.type == 'A') {
+                    spec.type = 'E';
+                }
+                Format::Detail::formatFloat(out, spec, value);
+                break;
+            }
+            case '%': out.put('%'); break;
+            default:
+                // Unsupported conversion, write it as-is. Nothing can be consumed since its type is unknown.
+                out.write(conversion, static_cast<std::size_t>(it - conversion) + (*it != '\0' ? 1 : 0));
+                break;
+        }
+        if (*it != '\0') { it++; }
+    }
+    va_end(argList);
+
+    if (size != 0) { buffer[std::min(out.length(), size - 1)] = '\0'; }
+    return out.length();
+}
+#endif
+
+std::size_t format(char* buffer, std::size_t size, const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    std::size_t length = vformat(buffer, size, fmt, args);
+    va_end(args);
+    return length;
+}
+}    // namespace Logging::Printf
@@ -0,0 +1,45 @@
+/**
+ * @file    mini_printf.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Small, reentrant printf for the log messages.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#ifndef VENDOR_LOGGING_MINI_PRINTF_H
+#define VENDOR_LOGGING_MINI_PRINTF_H
+
+#include <cstdarg>
+#include <cstddef>
+
+/**
+ * printf subset used by the log messages, without the locks, heap and stack appetite of newlib's vsnprintf. Only the
+ * caller's buffer and stack are touched, so it is safe to call from any task or interrupt.
+ *
+ * Supported: the `-+ #0` flags, width and precision (`*` included), the `hh h l ll j z t L` length modifiers and the
+ * `d i u o x X c s p %` conversions. `f F e E` are supported with at most 9 decimals, `g G a A` are written as `e`.
+ * `n` is not supported.
+ *
+ * Set LOGGER_USE_LIBC_PRINTF to 1 to use the libc's vsnprintf instead.
+ */
+namespace Logging::Printf {
+/**
+ * Same as vsnprintf.
+ * @return The length of the whole output, which was truncated if it is greater or equal to `size`.
+ */
+std::size_t vformat(char* buffer, std::size_t size, const char* fmt, va_list args);
+
+//! Same as snprintf.
+[[gnu::format(printf, 3, 4)]] std::size_t format(char* buffer, std::size_t size, const char* fmt, ...);
+}    // namespace Logging::Printf
+
+#endif    // VENDOR_LOGGING_MINI_PRINTF_H
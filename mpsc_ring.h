@@ -0,0 +1,232 @@
+/**
+ * @file    mpsc_ring.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Lock-free multi-producer, single consumer ring of variable-length records.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef VENDOR_LOGGING_MPSC_RING_H
+#define VENDOR_LOGGING_MPSC_RING_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Logging {
+/**
+ * Byte ring where producers claim room for a record with a compare-and-swap, fill it in place and then commit it. The
+ * consumer reads the committed records in the order they were claimed, straight from the ring.
+ *
+ * No lock is ever taken, so tasks and interrupts can produce concurrently. A producer that gets interrupted between
+ * reserve() and commit() only delays the consumer, never the other producers.
+ *
+ * Claiming is lock-free, not wait-free: a producer whose compare-and-swap lost to another one retries, so under heavy
+ * contention a low priority producer can keep retrying while the others make progress. The compare-and-swap only loses
+ * when another producer claimed room in between, so a producer that is never preempted by other producers of the ring
+ * claims on its first try; LanedRing gives tasks and interrupt priorities a ring of their own for that.
+ *
+ * Every record is contiguous: when a record doesn't fit before the end of the ring, the remaining bytes are skipped
+ * with a padding record.
+ *
+ * @tparam Capacity Size of the ring in bytes, must be a power of two.
+ *
+ * @attention Requires a lock-free compare-and-swap, i.e. not Cortex-M0.
+ */
+template<std::size_t Capacity>
+class MpscRing {
+    static_assert(std::has_single_bit(Capacity), "Capacity must be a power of two");
+
+    struct Header {
+        std::uint32_t state;     //!< Flags and size of the whole record, header and padding included.
+        std::uint32_t length;    //!< Length of the data.
+    };
+
+    static constexpr std::size_t   s_alignment     = sizeof(Header);
+    static constexpr std::uint32_t s_committedFlag = 1U << 31;
+    static constexpr std::uint32_t s_paddingFlag   = 1U << 30;
+    static constexpr std::uint32_t s_sizeMask      = s_paddingFlag - 1;
+
+    static_assert(Capacity >= 2 * sizeof(Header), "Capacity is too small");
+    static_assert(Capacity <= s_sizeMask, "Capacity is too large");
+
+    // The consumer zeroes every byte it frees, so that leftovers of previous records never look like a header.
+    alignas(Header) std::uint32_t m_storage[Capacity / sizeof(std::uint32_t)] = {};
+
+    std::atomic<std::size_t> m_head = 0;    //!< Claimed by the producers.
+    std::atomic<std::size_t> m_tail = 0;    //!< Freed by the consumer.
+    std::size_t              m_read = 0;    //!< Read by the consumer, not freed yet.
+
+public:
+    struct Record {
+        const char* data   = nullptr;
+        std::size_t length = 0;
+    };
+
+    //! Largest record that the ring can ever hold.
+    static constexpr std::size_t s_maxLength = Capacity - sizeof(Header);
+
+    /**
+     * Claims room for a record. Safe to call from any context.
+     * @param length Length of the data, in bytes.
+     * @param limit Most bytes the ring may hold once the record is claimed, headers and padding included, to keep the
+     * rest for other records.
+     * @return Where to write the data, or nullptr if there isn't enough room.
+     */
+    char* reserve(std::size_t length, std::size_t limit = Capacity)
+    {
+        if (length > s_maxLength) { return nullptr; }
+        const std::size_t size = alignUp(sizeof(Header) + length);
+
+        // Acquire the head so that the bytes given back by commit() are seen zeroed.
+        std::size_t head    = m_head.load(std::memory_order_acquire);
+        std::size_t padding = 0;
+        do {
+            const std::size_t offset = head & (Capacity - 1);
+            padding                  = (Capacity - offset < size) ? Capacity - offset : 0;
+            // Acquire the tail so that the consumer's zeroing is visible before we write over it.
+            if (head + padding + size - m_tail.load(std::memory_order_acquire) > limit) { return nullptr; }
+        } while (!m_head.compare_exchange_weak(head, head + padding + size, std::memory_order_acquire));
+
+        if (padding != 0) {
+            Header& skipped = headerAt(head);
+            skipped.length  = 0;
+            std::atomic_ref {skipped.state}.store(
+              s_committedFlag | s_paddingFlag | static_cast<std::uint32_t>(padding), std::memory_order_release);
+            head += padding;
+        }
+
+        Header& header = headerAt(head);
+        header.length  = static_cast<std::uint32_t>(length);
+        return reinterpret_cast<char*>(&header + 1);
+    }
+
+    /**
+     * Hands a reserved record over to the consumer.
+     * @param data Pointer returned by reserve().
+     */
+    void commit(char* data)
+    {
+        Header&             header = *(reinterpret_cast<Header*>(data) - 1);
+        const std::uint32_t size   = static_cast<std::uint32_t>(alignUp(sizeof(Header) + header.length));
+        std::atomic_ref {header.state}.store(s_committedFlag | size, std::memory_order_release);
+    }
+
+    /**
+     * Hands a reserved record over to the consumer, shrinking it to the length actually used.
+     *
+     * The unused room is given back to the ring if no other record was reserved after this one in the meantime.
+     *
+     * @param data Pointer returned by reserve().
+     * @param length Length of the data, at most the reserved length. One more byte may have been written past it.
+     */
+    void commit(char* data, std::size_t length)
+    {
+        Header&           header   = *(reinterpret_cast<Header*>(data) - 1);
+        const std::size_t reserved = alignUp(sizeof(Header) + header.length);
+        std::size_t       size     = alignUp(sizeof(Header) + length);
+
+        if (size < reserved) {
+            // The bytes we give back must be zeroed, like the consumer does, before anyone else can claim them.
+            const std::size_t written = std::min(sizeof(Header) + length + 1, reserved);
+            if (written > size) { std::memset(reinterpret_cast<char*>(&header) + size, 0, written - size); }
+
+            // The record can't be committed, so the head is less than a lap ahead of it.
+            const std::size_t start = reinterpret_cast<char*>(&header) - reinterpret_cast<char*>(&m_storage[0]);
+            std::size_t       head  = m_head.load(std::memory_order_relaxed);
+            if ((head & (Capacity - 1)) != ((start + reserved) & (Capacity - 1)) ||
+                !m_head.compare_exchange_strong(head, head - (reserved - size), std::memory_order_release)) {
+                // Someone reserved after us, keep the whole reservation.
+                size = reserved;
+            }
+        }
+
+        header.length = static_cast<std::uint32_t>(length);
+        std::atomic_ref {header.state}.store(s_committedFlag | static_cast<std::uint32_t>(size),
+                                             std::memory_order_release);
+    }
+
+    /**
+     * Bytes claimed and not freed yet, headers and padding included. Safe to call from any context, but only a hint
+     * while the producers and the consumer are busy.
+     */
+    std::size_t used() const
+    {
+        // Load the tail first, the head can't be behind it.
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        return m_head.load(std::memory_order_relaxed) - tail;
+    }
+
+    /**
+     * Gets the next committed record. Consumer only.
+     *
+     * The record stays valid until release() is called. Several records can be read before releasing them.
+     *
+     * @return False if there's nothing to read, or if the oldest record isn't committed yet.
+     */
+    bool read(Record& record)
+    {
+        if (!peek(record)) { return false; }
+        m_read += std::atomic_ref {headerAt(m_read).state}.load(std::memory_order_relaxed) & s_sizeMask;
+        return true;
+    }
+
+    /**
+     * Same as read(), without moving on to the next record: the next peek() or read() gets the same record.
+     */
+    bool peek(Record& record)
+    {
+        while (true) {
+            // When the ring is full, the next header is the oldest record that wasn't released yet.
+            if (m_read - m_tail.load(std::memory_order_relaxed) == Capacity) { return false; }
+
+            Header&             header = headerAt(m_read);
+            const std::uint32_t state  = std::atomic_ref {header.state}.load(std::memory_order_acquire);
+            if ((state & s_committedFlag) == 0) { return false; }
+
+            if ((state & s_paddingFlag) == 0) {
+                record = {reinterpret_cast<const char*>(&header + 1), header.length};
+                return true;
+            }
+            m_read += state & s_sizeMask;
+        }
+    }
+
+    /**
+     * Frees every record read so far. Consumer only.
+     */
+    void release()
+    {
+        std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        auto*       ring = reinterpret_cast<char*>(&m_storage[0]);
+        while (tail != m_read) {
+            const std::size_t offset = tail & (Capacity - 1);
+            const std::size_t length = std::min(m_read - tail, Capacity - offset);
+            std::memset(ring + offset, 0, length);
+            tail += length;
+        }
+        m_tail.store(tail, std::memory_order_release);
+    }
+
+private:
+    static constexpr std::size_t alignUp(std::size_t size) { return (size + s_alignment - 1) & ~(s_alignment - 1); }
+
+    Header& headerAt(std::size_t position)
+    {
+        return *reinterpret_cast<Header*>(reinterpret_cast<char*>(&m_storage[0]) + (position & (Capacity - 1)));
+    }
+};
+}    // namespace Logging
+
+#endif    // VENDOR_LOGGING_MPSC_RING_H
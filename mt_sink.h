@@ -19,107 +19,269 @@
 #ifndef VENDOR_LOGGING_MT_SINK_H
 #define VENDOR_LOGGING_MT_SINK_H
 
+#include "binary_format.h"
+#include "config.h"
+#include "laned_ring.h"
+#include "log_worker.h"
+#include "logger.h"
+#include "mpsc_ring.h"
+#include "priority_ring.h"
+#include "mt_sink_policy.h"
+#include "mt_sink_tracer.h"
+#include "port.h"
 #include "sink.h"
 
 #include <FreeRTOS.h>
-#include <message_buffer.h>
 #include <semphr.h>
 #include <task.h>
 
 #include <algorithm>
+#include <atomic>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <type_traits>
 #include <utility>
 
 #if (INCLUDE_vTaskDelete != 1)
 #    error "vTaskDelete is required by MtSink, please set INCLUDE_vTaskDelete to 1"
 #endif
-extern unsigned int g_yieldedCauseFull;
+#if LOGGER_STATIC_CONFIG && (configSUPPORT_STATIC_ALLOCATION != 1)
+#    error "LOGGER_STATIC_CONFIG requires configSUPPORT_STATIC_ALLOCATION to be set to 1"
+#endif
 namespace Logging {
 /**
  * Multi-Producer, Single Consumer sink.
+ *
+ * Producers copy their message into a lock-free ring, a low priority task then hands them over to the real sink in
+ * batches, see Sink::onWriteBatch. The task is either the sink's own, or a LogWorker shared with other sinks, see
+ * MtSinkPolicy::sharedWorker. It only wakes up when a message is queued or the real sink has to be flushed.
+ *
+ * Besides the messages handed over by the Logger, the statistics of the sink count the drops (along with the transport
+ * drops of T), the high-water mark of the ring, the time spent by the task and the longest time a message was queued,
+ * measured with Logger::now.
  * @tparam T
+ * @tparam BufferSize Size of the ring in bytes, must be a power of two. A record takes 8 bytes of header + a 4 bytes
+ * timestamp + the level + the message. The default is big enough for a few full-size reservations made by the Logger.
+ * @tparam Queue Ring the messages go through, MpscRing or a ring with the same interface. With `Lanes<N, M>::Ring`, up
+ * to N tasks registered with registerProducer and the interrupts of M priorities registered with
+ * registerInterruptPriority get a ring of BufferSize bytes of their own, see LanedRing. With
+ * `Priorities<Levels...>::Ring`, each group of levels gets a ring of BufferSize bytes and the most severe ones are
+ * delivered first, see PriorityRing. In binary mode, its messages then take 9 more bytes for their sequence record.
+ * @tparam Policy What to do when the ring is full, the room kept for errors and warnings and the parameters of the
+ * task, see MtSinkPolicy.
  *
  * @attention T's onWrite method must accept strings that are not null terminated.
  */
-template<std::derived_from<Sink> T>
-class MtSink : public Sink {
-    struct MessageHeader {
-        Level       level = {};
-        std::size_t len   = 0;
+template<std::derived_from<Sink> T,
+         std::size_t BufferSize            = 2048,
+         template<std::size_t> class Queue = MpscRing,
+         typename Policy                   = MtSinkPolicy>
+class MtSink : public Sink, private LogWorkerBase::Client {
+    using Ring = Queue<BufferSize>;
+
+    static_assert(Policy::reservedBytes < BufferSize, "The reserved room must leave some for the other levels");
+    static_assert(Policy::samplePercent <= 100, "samplePercent is a percentage");
+    static_assert(Policy::sampleRate != 0, "sampleRate must be at least 1");
+    static_assert(Policy::batchMaxCount != 0, "batchMaxCount must be at least 1");
+
+#if LOGGER_MT_SINK_TRACING
+    //! Start of a message, kept at the start of its record until it is committed.
+    struct Trace {
+        std::uint32_t sequence   = 0;
+        std::uint64_t startTicks = 0;
     };
-
-    //! Size in bytes.
-    static constexpr std::size_t s_messageMaxLen          = 128;
-    static constexpr std::size_t s_maxLenMessagesInBuffer = 8;
-    //! Size of the header used internally by FreeRTOS's message buffer.
-    static constexpr std::size_t s_internalMessageHeaderLen = sizeof(configMESSAGE_BUFFER_LENGTH_TYPE);
-    //! A message always has the Level, the length of the message, then the message itself.
-    static constexpr std::size_t s_messageBufferSize =
-      (sizeof(MessageHeader) + s_messageMaxLen + s_internalMessageHeaderLen) * s_maxLenMessagesInBuffer;
-
-    //! Maximum amount of time (in ms) that a producer can wait when writing messages.
-    static constexpr auto s_producerMaxBlockTime = portMAX_DELAY;
-
+    //! enqueueTicks[8] sequence[4]
+    static constexpr std::size_t s_traceSize = sizeof(std::uint64_t) + sizeof(std::uint32_t);
+#else
+    struct Trace {};
+    static constexpr std::size_t s_traceSize = 0;
+#endif
+    //! Low 32 bits of Logger::now() when the record was committed, for the latency statistics.
+    static constexpr std::size_t s_stampSize   = sizeof(std::uint32_t);
+    static constexpr std::size_t s_levelOffset = s_traceSize + s_stampSize;
+    static constexpr std::size_t s_sequenceOffset = s_levelOffset + sizeof(Level);
+    /**
+     * With a queue that reorders the messages (PriorityRing), each binary message goes out after a sequence record,
+     * for the host decoder to tell the messages that were overtaken. Part of the message handed to the real sink.
+     */
+    static constexpr std::size_t s_sequenceSize =
+      LOGGER_USE_BINARY_FORMAT && requires(const char* data) { Ring::sequenceOf(data); } ? Binary::s_sequenceFrameSize
+                                                                                         : 0;
+    //! The trace, if enabled, the timestamp, the level and the sequence record, if any, go before the message.
+    static constexpr std::size_t s_recordHeaderSize = s_sequenceOffset + s_sequenceSize;
+    //! Largest message that can be queued, in bytes.
+    static constexpr std::size_t s_messageMaxLen =
+      std::min(Policy::messageMaxLength, Ring::s_maxLength - s_recordHeaderSize);
+
+    //! Most bytes of the ring the levels below warning can use, see MtSinkPolicy::reservedBytes.
+    static constexpr std::size_t s_commonLimit = BufferSize - Policy::reservedBytes;
+    //! Past this many bytes, OverflowStrategy::sample only queues some of the levels below warning.
+    static constexpr std::size_t s_sampleLimit = s_commonLimit * Policy::samplePercent / 100;
+
+    //! Maximum number of messages handed over to the real sink in a single batch.
+    static constexpr std::size_t s_batchMaxCount = Policy::batchMaxCount;
+
+    //! Room left on the task's stack for the batch and the real sink.
+    static constexpr std::size_t s_sinkStackBudget =
+      Policy::sinkStackSize + s_batchMaxCount * (sizeof(Message) + (LOGGER_MT_SINK_TRACING ? sizeof(Trace) : 0));
     static constexpr std::size_t s_taskStackSize =
-      configMINIMAL_STACK_SIZE + (s_messageMaxLen / sizeof(configSTACK_DEPTH_TYPE));
-    static constexpr UBaseType_t s_taskPriority = 1;    //!< Low priority.
-    //! Task will check whether it needs to stop running once every `s_taskRefreshPeriod` ms.
-    static constexpr std::size_t s_taskRefreshPeriod = pdMS_TO_TICKS(10);
-
-    MessageBufferHandle_t m_messageBuffer = nullptr;
-    TaskHandle_t          m_task          = nullptr;
-
-    SemaphoreHandle_t m_semaphoreHandle = nullptr;
-    StaticSemaphore_t m_semaphoreBuffer = {};
-
-    volatile bool m_taskShouldRun = true;
-    volatile bool m_taskIsRunning = false;
+      configMINIMAL_STACK_SIZE + (s_sinkStackBudget / sizeof(configSTACK_DEPTH_TYPE));
+    static constexpr UBaseType_t s_taskPriority = Policy::taskPriority;
+    //! The real sink is flushed once nothing came in for this long, see Sink::flush.
+    static constexpr TickType_t s_idleFlushDelay = pdMS_TO_TICKS(10);
+    //! Longest time the real sink can keep messages buffered.
+    static constexpr TickType_t s_flushPeriod = pdMS_TO_TICKS(20);
+
+    Ring           m_ring;
+    TaskHandle_t   m_task   = nullptr;    //!< The task draining the ring, the LogWorker's with a shared worker.
+    LogWorkerBase* m_worker = nullptr;
+#if LOGGER_STATIC_CONFIG
+    struct TaskStorage {
+        StackType_t  stack[s_taskStackSize];
+        StaticTask_t buffer;
+    };
+    struct NoTaskStorage {};
+    //! The stack and TCB of the task, only if the sink has a task of its own.
+    [[no_unique_address]] std::conditional_t<Policy::sharedWorker, NoTaskStorage, TaskStorage> m_taskStorage;
+#endif
 
-    std::size_t m_messagesDropped = 0;
+    std::atomic<bool> m_taskShouldRun = true;
+    std::atomic<bool> m_taskIsRunning = false;
+
+    bool       m_flushPending = false;
+    TickType_t m_pendingSince = 0;    //!< When the real sink was first handed messages since it was last flushed.
+    TickType_t m_lastDrained  = 0;
+
+    std::atomic<std::size_t> m_messagesDropped = 0;
+    //! Set by the producers when the ring is full, with OverflowStrategy::dropOldest.
+    std::atomic<bool> m_roomWanted = false;
+    //! Messages considered while sampling, with OverflowStrategy::sample.
+    std::atomic<std::uint32_t> m_sampleCount = 0;
+
+    //! Wakes up the tasks waiting for room in the ring once the consumer freed some, see waitForRoom.
+    struct RoomSignal {
+        StaticSemaphore_t          buffer {};
+        SemaphoreHandle_t          roomFreed = xSemaphoreCreateBinaryStatic(&buffer);
+        std::atomic<std::uint32_t> waiters   = 0;
+
+        RoomSignal() = default;
+        RoomSignal(const RoomSignal&)            = delete;
+        RoomSignal& operator=(const RoomSignal&) = delete;
+        ~RoomSignal() { vSemaphoreDelete(roomFreed); }
+    };
+    struct NoRoomSignal {};
+    static constexpr bool s_producersWait =
+      Policy::overflow == OverflowStrategy::block || Policy::overflow == OverflowStrategy::dropOldest;
+    [[no_unique_address]] std::conditional_t<s_producersWait, RoomSignal, NoRoomSignal> m_roomSignal;
+
+#if LOGGER_MT_SINK_TRACING
+    MtSinkTracer*              m_tracer   = nullptr;
+    std::atomic<std::uint32_t> m_sequence = 0;
+#endif
 
 public:
     template<typename... Args>
-        requires std::constructible_from<T, Args...>
+        requires(!Policy::sharedWorker && std::constructible_from<T, Args...>)
     MtSink(Args&&... args) : m_sink(std::forward<Args>(args)...)
     {
-        // Create semaphore,
-        m_semaphoreHandle = xSemaphoreCreateMutexStatic(&m_semaphoreBuffer);
-        configASSERT(m_semaphoreHandle != nullptr);
-
-        // Create message buffer,
-        m_messageBuffer = xMessageBufferCreate(s_messageBufferSize);
-        configASSERT(m_messageBuffer != nullptr);
-
         // Create task,
-        auto res = xTaskCreate(&task, "MtSink", s_taskStackSize, this, configMAX_PRIORITIES - 1, &m_task);
+#if LOGGER_STATIC_CONFIG
+        m_task = xTaskCreateStatic(&task,
+                                   "MtSink",
+                                   s_taskStackSize,
+                                   this,
+                                   configMAX_PRIORITIES - 1,
+                                   &m_taskStorage.stack[0],
+                                   &m_taskStorage.buffer);
+        configASSERT(m_task != nullptr);
+#else
+        [[maybe_unused]] auto res =
+          xTaskCreate(&task, "MtSink", s_taskStackSize, this, configMAX_PRIORITIES - 1, &m_task);
         configASSERT(res == pdPASS);
+#endif
     }
+
+    /**
+     * Creates a sink drained by a shared worker, see MtSinkPolicy::sharedWorker.
+     * @param worker Must outlive the sink.
+     */
+    template<typename... Args>
+        requires(Policy::sharedWorker && std::constructible_from<T, Args...>)
+    MtSink(LogWorkerBase& worker, Args&&... args) : m_worker(&worker), m_sink(std::forward<Args>(args)...)
+    {
+        m_task          = worker.taskHandle();
+        m_taskIsRunning = true;
+        worker.add(*this);
+    }
+
     MtSink(const MtSink&)            = delete;
     MtSink& operator=(const MtSink&) = delete;
     MtSink(MtSink&&)                 = delete;
     MtSink& operator=(MtSink&&)      = delete;
 
-    // TODO should we wait for message buffer to be empty?
+    // TODO should we wait for the ring to be empty?
     ~MtSink() override
     {
+        if constexpr (Policy::sharedWorker) {
+            m_taskIsRunning = false;
+            // Waits for the worker to be done with us.
+            m_worker->remove(*this);
+            m_sink.flush();
+            return;
+        }
+
         if (m_taskIsRunning && m_task != nullptr) {
             // Ask the worker to shut down; it will delete itself.
             m_taskShouldRun = false;
+            xTaskNotifyGive(m_task);
             // Increase its priority to ours +1 so that it can stop sooner.
             vTaskPrioritySet(m_task, uxTaskPriorityGet(nullptr) + 1);
             while (m_taskIsRunning) {
                 portYIELD();
             }
-
-            // We can now assume that the worker will not be using the message buffer, and that producers will not try
-            // to take the semaphore and write to the message buffer.
-            vMessageBufferDelete(m_messageBuffer);
-            vSemaphoreDelete(m_semaphoreHandle);
         }
+#if LOGGER_STATIC_CONFIG
+        // The task's stack and TCB are members, it must be gone before they are.
+        if (m_task != nullptr) { vTaskDelete(m_task); }
+#endif
+    }
+
+    /**
+     * Gives a task a ring of its own, only with a Queue that has lanes, see LanedRing::registerProducer.
+     * @return False if every lane is taken.
+     */
+    bool registerProducer(TaskHandle_t task = nullptr)
+        requires requires(Ring& ring) { ring.registerProducer(task); }
+    {
+        return m_ring.registerProducer(task);
+    }
+
+    //! See LanedRing::unregisterProducer.
+    void unregisterProducer(TaskHandle_t task = nullptr)
+        requires requires(Ring& ring) { ring.unregisterProducer(task); }
+    {
+        m_ring.unregisterProducer(task);
+    }
+
+    /**
+     * Gives the interrupts of a priority a ring of their own, only with a Queue that has interrupt lanes, see
+     * LanedRing::registerInterruptPriority.
+     * @return False if every interrupt lane is taken.
+     */
+    bool registerInterruptPriority(std::uint8_t priority)
+        requires requires(Ring& ring) { ring.registerInterruptPriority(priority); }
+    {
+        return m_ring.registerInterruptPriority(priority);
     }
 
+#if LOGGER_MT_SINK_TRACING
+    //! Must be set before any message is logged.
+    void setTracer(MtSinkTracer* tracer) { m_tracer = tracer; }
+#endif
+
     /**
      * Queues the message to be sent to the real sink.
      *
@@ -127,9 +289,8 @@ public:
      * @param string
      * @param length
      *
-     * @attention When called from an interrupt, the message will be dropped if:
-     *  - The mutex is already locked, either from an irq with lower preemption or from the task that was interrupted
-     *  <br>- The message buffer does not have enough room to fit the whole message in it.
+     * @attention The message is dropped if it is longer than s_messageMaxLen. What happens when the ring doesn't have
+     * enough room for it depends on the OverflowStrategy of the Policy, interrupts never wait.
      */
     void onWrite(Level level, const char* string, std::size_t length) override
     {
@@ -137,19 +298,81 @@ public:
             // Don't do work for no reason lol
             return;
         }
-        if (!m_taskIsRunning) {
+        if (!m_taskIsRunning.load(std::memory_order_relaxed)) {
             // In space, no one can hear you scream.
             // The worker isn't running, so why should we bother?
             return;
         }
 
-        if ((portNVIC_INT_CTRL_REG & 0x1FF) != 0) {
-            // Function was called from an interrupt.
-            onWriteIrq(level, string, length);
+        // Function was called from an interrupt?
+        const bool  fromIrq = Port::isInIsr();
+        const Trace trace   = startTrace();
+        if (length > s_messageMaxLen) {
+            drop(DropCause::tooLong, trace, fromIrq);
+            return;
         }
-        else {
-            onWriteBlocking(level, string, length);
+        char* record = claim(level, s_recordHeaderSize + length, fromIrq, trace);
+        if (record == nullptr) {
+            // Already counted.
+            return;
         }
+
+        writeHeader(record, level, trace);
+        writeSequence(record);
+        std::memcpy(record + s_recordHeaderSize, string, length);
+        const std::uint64_t enqueueTicks = stampEnqueue(record);
+        stampQueued(record);
+        m_ring.commit(record);
+        notifyConsumer(fromIrq);
+        traceEnqueued(trace, enqueueTicks);
+    }
+
+    /**
+     * Reserves room for a message directly in the ring.
+     *
+     * Never waits: if the ring doesn't have maxLength bytes free, nullptr is returned and the message goes through
+     * onWrite instead, which is able to wait for just the room it needs or apply the OverflowStrategy.
+     */
+    char* reserve(Level level, std::size_t maxLength) override
+    {
+        if (!m_taskIsRunning.load(std::memory_order_relaxed) || maxLength > s_messageMaxLen) { return nullptr; }
+
+        // While sampling, onWrite decides which messages get through.
+        const std::size_t limit = (Policy::overflow == OverflowStrategy::sample && !isCritical(level))
+                                    ? s_sampleLimit
+                                    : limitFor(level);
+        char* record = reserveIn(level, s_recordHeaderSize + maxLength, limit);
+        if (record == nullptr) {
+            // Not a drop, onWrite takes over and numbers the message.
+            return nullptr;
+        }
+        const Trace trace = startTrace();
+        updateHighWater(record);
+        writeHeader(record, level, trace);
+        writeSequence(record);
+        return record + s_recordHeaderSize;
+    }
+
+    void commit(char* buffer, std::size_t length) override
+    {
+        char*               record       = buffer - s_recordHeaderSize;
+        const Trace         trace        = readTrace(record);
+        const std::uint64_t enqueueTicks = stampEnqueue(record);
+        stampQueued(record);
+        // Empty messages are committed as well, the reservation has to be handed back.
+        m_ring.commit(record, s_recordHeaderSize + length);
+        notifyConsumer(Port::isInIsr());
+        traceEnqueued(trace, enqueueTicks);
+    }
+
+    SinkStats::Snapshot snapshotStats() const override
+    {
+        SinkStats::Snapshot       snapshot = Sink::snapshotStats();
+        const SinkStats::Snapshot inner    = m_sink.snapshotStats();
+        for (std::size_t i = 0; i < SinkStats::s_dropCauseCount; i++) {
+            snapshot.dropped[i] += inner.dropped[i];
+        }
+        return snapshot;
     }
 
 protected:
@@ -160,140 +383,346 @@ protected:
     }
 
 private:
-    void onWriteBlocking(Level level, const char* string, std::size_t length)
-    {
-        // TODO should we set a timeout to lock? If yes, what do we do on timeout, drop the message?
-        if (xSemaphoreTake(m_semaphoreHandle, s_producerMaxBlockTime) == pdPASS) {
-            // Send the message header first.
-            MessageHeader header {level, length};
-            xMessageBufferSend(m_messageBuffer, &header, sizeof(header), s_producerMaxBlockTime);
-
-            // Send the message in chunks that can be read by the consumer.
-            const char* ptr = string;
-            while (length != 0) {
-                std::size_t chunkLength = std::min(length, s_messageMaxLen);
-                xMessageBufferSend(m_messageBuffer, ptr, chunkLength, s_producerMaxBlockTime);
-                ptr += chunkLength;
-                length -= chunkLength;
-            }
-            xSemaphoreGive(m_semaphoreHandle);
+    //! Claims room in the ring, in the lane of the level if the ring has lanes by level.
+    char* reserveIn(Level level, std::size_t length, std::size_t limit)
+    {
+        if constexpr (requires { m_ring.reserve(level, length, limit); }) {
+            return m_ring.reserve(level, length, limit);
         }
         else {
-            // Unable to take the mutex, drop the message.
-            ++m_messagesDropped;
+            return m_ring.reserve(length, limit);
         }
     }
 
-    void onWriteIrq(Level level, const char* string, std::size_t length)
-    {
-        if (xSemaphoreTakeFromISR(m_semaphoreHandle, nullptr) == pdPASS) {
-            if (xMessageBufferSpaceAvailable(m_messageBuffer) >= getRealMessageLen(length)) {
-                // Send the message header first.
-                MessageHeader header {level, length};
-                xMessageBufferSendFromISR(m_messageBuffer, &header, sizeof(header), nullptr);
+    //! Errors and warnings can use the reserved room, and are never discarded or sampled.
+    static constexpr bool isCritical(Level level) { return level == Level::error || level == Level::warning; }
 
-                // Send the message in chunks that can be read by the consumer.
-                const char* ptr = string;
-                while (length != 0) {
-                    std::size_t chunkLength = std::min(length, s_messageMaxLen);
-                    xMessageBufferSendFromISR(m_messageBuffer, ptr, chunkLength, nullptr);
-                    ptr += chunkLength;
-                    length -= chunkLength;
+    static constexpr std::size_t limitFor(Level level) { return isCritical(level) ? BufferSize : s_commonLimit; }
+
+    /**
+     * Claims room for a record, applying the OverflowStrategy if there isn't enough.
+     * @return The record, or nullptr if the message was dropped, in which case the drop is already counted.
+     */
+    char* claim(Level level, std::size_t length, bool fromIrq, const Trace& trace)
+    {
+        const std::size_t limit  = limitFor(level);
+        char*             record = nullptr;
+        if constexpr (Policy::overflow == OverflowStrategy::sample) {
+            if (!isCritical(level)) {
+                record = reserveIn(level, length, s_sampleLimit);
+                // Past the threshold, only one message in sampleRate may use the rest of the room.
+                if (record == nullptr &&
+                    m_sampleCount.fetch_add(1, std::memory_order_relaxed) % Policy::sampleRate != 0) {
+                    drop(DropCause::sampled, trace, fromIrq);
+                    return nullptr;
                 }
             }
-            else {
-                // Not enough room available in the buffer for the entire message, drop the message.
-                ++m_messagesDropped;
+        }
+        if (record == nullptr) { record = reserveIn(level, length, limit); }
+        if (record == nullptr) { record = waitForRoom(level, length, limit, fromIrq); }
+        if (record == nullptr) { drop(DropCause::full, trace, fromIrq); }
+        return updateHighWater(record);
+    }
+
+    //! Gets room in a full ring, as allowed by the OverflowStrategy.
+    char* waitForRoom(Level level, std::size_t length, std::size_t limit, bool fromIrq)
+    {
+        constexpr bool discards = Policy::overflow == OverflowStrategy::dropOldest;
+        if constexpr (!s_producersWait) { return nullptr; }
+        else {
+            if (discards) { requestRoom(fromIrq); }
+            if (fromIrq) { return nullptr; }
+
+            // Wait for the consumer to make some room, by delivering or discarding records. Registered as a waiter
+            // before the first attempt, so the room freed after any attempt wakes us up.
+            char*      record      = nullptr;
+            TickType_t ticksToWait = Policy::blockTime;
+            TimeOut_t  timeout;
+            vTaskSetTimeOutState(&timeout);
+            m_roomSignal.waiters.fetch_add(1, std::memory_order_seq_cst);
+            while (xTaskCheckForTimeOut(&timeout, &ticksToWait) == pdFALSE) {
+                record = reserveIn(level, length, limit);
+                if (record != nullptr) { break; }
+                if (discards) { requestRoom(fromIrq); }
+                xSemaphoreTake(m_roomSignal.roomFreed, ticksToWait);
+            }
+            // The other waiters might fit in what's left too. If there wasn't enough room for us, the consumer wakes
+            // them up once it frees some more.
+            if (m_roomSignal.waiters.fetch_sub(1, std::memory_order_seq_cst) > 1 && record != nullptr) {
+                xSemaphoreGive(m_roomSignal.roomFreed);
             }
+            return record;
+        }
+    }
 
-            xSemaphoreGiveFromISR(m_semaphoreHandle, nullptr);
+    //! Wakes up a task waiting in waitForRoom, after the consumer freed some room.
+    void signalRoom()
+    {
+        if constexpr (s_producersWait) {
+            if (m_roomSignal.waiters.load(std::memory_order_seq_cst) != 0) { xSemaphoreGive(m_roomSignal.roomFreed); }
+        }
+    }
+
+    //! Asks the consumer to discard its next batch, see OverflowStrategy::dropOldest.
+    void requestRoom(bool fromIrq)
+    {
+        m_roomWanted.store(true, std::memory_order_relaxed);
+        notifyConsumer(fromIrq);
+    }
+
+    void drop(DropCause cause, const Trace& trace, bool fromIrq)
+    {
+        Sink::stats().drop(cause);
+        m_messagesDropped.fetch_add(1, std::memory_order_relaxed);
+        traceDropped(trace, fromIrq);
+    }
+
+    char* updateHighWater(char* record)
+    {
+        if (record != nullptr) { Sink::stats().queueHighWater.max(static_cast<std::uint32_t>(m_ring.used())); }
+        return record;
+    }
+
+#if LOGGER_MT_SINK_TRACING
+    Trace startTrace()
+    {
+        return {m_sequence.fetch_add(1, std::memory_order_relaxed), m_tracer != nullptr ? m_tracer->now() : 0};
+    }
+
+    // Until the record is committed, its enqueue time holds the start time of the producer.
+    static void writeHeader(char* record, Level level, const Trace& trace)
+    {
+        std::memcpy(record, &trace.startTicks, sizeof(trace.startTicks));
+        std::memcpy(record + sizeof(std::uint64_t), &trace.sequence, sizeof(trace.sequence));
+        record[s_levelOffset] = static_cast<char>(level);
+    }
+
+    static Trace readTrace(const char* record)
+    {
+        Trace trace;
+        std::memcpy(&trace.startTicks, record, sizeof(trace.startTicks));
+        std::memcpy(&trace.sequence, record + sizeof(std::uint64_t), sizeof(trace.sequence));
+        return trace;
+    }
+
+    std::uint64_t stampEnqueue(char* record)
+    {
+        const std::uint64_t ticks = m_tracer != nullptr ? m_tracer->now() : 0;
+        std::memcpy(record, &ticks, sizeof(ticks));
+        return ticks;
+    }
+
+    void traceEnqueued(const Trace& trace, std::uint64_t enqueueTicks)
+    {
+        if (m_tracer != nullptr) { m_tracer->onEnqueued(trace.sequence, enqueueTicks, enqueueTicks - trace.startTicks); }
+    }
+
+    void traceDropped(const Trace& trace, bool fromIrq)
+    {
+        if (m_tracer != nullptr) { m_tracer->onDropped(trace.sequence, fromIrq); }
+    }
+
+    void traceDiscarded(const char* record)
+    {
+        if (m_tracer != nullptr) { m_tracer->onDropped(readTrace(record).sequence, false); }
+    }
+#else
+    static Trace startTrace() { return {}; }
+    static void  writeHeader(char* record, Level level, const Trace& /*trace*/)
+    {
+        record[s_levelOffset] = static_cast<char>(level);
+    }
+    static Trace         readTrace(const char* /*record*/) { return {}; }
+    static std::uint64_t stampEnqueue(char* /*record*/) { return 0; }
+    static void          traceEnqueued(const Trace& /*trace*/, std::uint64_t /*enqueueTicks*/) {}
+    static void          traceDropped(const Trace& /*trace*/, bool /*fromIrq*/) {}
+    static void          traceDiscarded(const char* /*record*/) {}
+#endif
+
+    static void writeSequence(char* record)
+    {
+        if constexpr (s_sequenceSize != 0) {
+            Binary::Encoder encoder {record + s_sequenceOffset, s_sequenceSize};
+            encoder.sequence(Ring::sequenceOf(record));
+            encoder.finish();
+        }
+    }
+
+    static void stampQueued(char* record)
+    {
+        const auto ticks = static_cast<std::uint32_t>(Logger::now());
+        std::memcpy(record + s_traceSize, &ticks, sizeof(ticks));
+    }
+
+    static std::uint32_t toMicroseconds(std::uint64_t ticks)
+    {
+        return static_cast<std::uint32_t>(ticks * 1'000'000 / Logger::getTicksPerSecond());
+    }
+
+    void notifyConsumer(bool fromIrq)
+    {
+        if (fromIrq) {
+            // The consumer has a low priority, no need to yield.
+            vTaskNotifyGiveFromISR(m_task, nullptr);
+        }
+        else {
+            xTaskNotifyGive(m_task);
+        }
+    }
+
+    void reportDroppedMessages()
+    {
+        std::size_t dropped = m_messagesDropped.exchange(0, std::memory_order_relaxed);
+        if (dropped == 0) { return; }
+
+        if constexpr (LOGGER_USE_BINARY_FORMAT) {
+            // A record of its own, so that the decoder shows it and the captures of the stream keep it.
+            char            frame[Binary::s_droppedFrameSize];
+            Binary::Encoder encoder {&frame[0], sizeof(frame)};
+            encoder.dropped(Logger::now(), static_cast<std::uint32_t>(dropped));
+            onWriteImpl(Level::error, &frame[0], encoder.finish());
         }
         else {
-            // Unable to take the mutex, drop the message.
-            ++m_messagesDropped;
+            char        msg[30];
+            std::size_t len =
+              std::snprintf(&msg[0], sizeof(msg), "Dropped %u messages!", static_cast<unsigned int>(dropped));
+            onWriteImpl(Level::error, &msg[0], len);
         }
     }
 
     /**
-     * Calculates the number of bytes a message of size len will actually occupy in the message buffer, including all
-     * the overhead.
-     * @param len The length of the message
-     * @return The number of bytes that the message would take in the message buffer.
+     * Hands the queued messages over to the real sink in one batch, straight from the ring, then frees them.
+     *
+     * When the producers asked for room (OverflowStrategy::dropOldest), the messages of the batch are discarded
+     * instead, errors and warnings excepted.
+     * @return The number of records read, there might be more to drain if the batch was full.
      */
-    std::size_t getRealMessageLen(std::size_t len)
+    std::size_t drainBatch()
     {
-        std::size_t realLen = s_internalMessageHeaderLen + sizeof(MessageHeader);
+        Message               batch[s_batchMaxCount];
+        std::uint32_t         oldestStamp = 0;
+        std::size_t           count       = 0;
+        std::size_t           read        = 0;
+        std::uint32_t         discarded   = 0;
+        typename Ring::Record record;
+#if LOGGER_MT_SINK_TRACING
+        Trace traces[s_batchMaxCount];
+#endif
+        const bool discard =
+          Policy::overflow == OverflowStrategy::dropOldest && m_roomWanted.exchange(false, std::memory_order_relaxed);
+        while (read < s_batchMaxCount && m_ring.read(record)) {
+            read++;
+            if (record.length <= s_recordHeaderSize) { continue; }
+
+            const auto level = static_cast<Level>(record.data[s_levelOffset]);
+            if (discard && !isCritical(level)) {
+                traceDiscarded(record.data);
+                discarded++;
+                continue;
+            }
+#if LOGGER_MT_SINK_TRACING
+            // The enqueue time, now that the record is committed.
+            traces[count] = readTrace(record.data);
+#endif
+            // With lanes, the records aren't read in the order they were claimed.
+            std::uint32_t stamp;
+            std::memcpy(&stamp, record.data + s_traceSize, sizeof(stamp));
+            if (count == 0 || static_cast<std::int32_t>(stamp - oldestStamp) < 0) { oldestStamp = stamp; }
+            batch[count++] = {level, record.data + s_sequenceOffset, record.length - s_sequenceOffset};
+            if constexpr (requires { record.sequence; }) { batch[count - 1].sequence = record.sequence; }
+        }
+        if (discarded != 0) {
+            Sink::stats().drop(DropCause::overwritten, discarded);
+            m_messagesDropped.fetch_add(discarded, std::memory_order_relaxed);
+        }
+
+        if (count != 0) {
+            m_sink.onWriteBatch(&batch[0], count);
+            const auto latency = static_cast<std::uint32_t>(Logger::now()) - oldestStamp;
+            Sink::stats().maxLatencyMicroseconds.max(toMicroseconds(latency));
+        }
+#if LOGGER_MT_SINK_TRACING
+        if (m_tracer != nullptr && count != 0) {
+            const std::uint64_t now = m_tracer->now();
+            for (std::size_t i = 0; i < count; i++) {
+                m_tracer->onDelivered(traces[i].sequence,
+                                      traces[i].startTicks,
+                                      now,
+                                      batch[i].string + s_sequenceSize,
+                                      batch[i].length - s_sequenceSize);
+            }
+        }
+#endif
+        m_ring.release();
+        if (read != 0) { signalRoom(); }
+        return read;
+    }
 
-        while (len != 0) {
-            std::size_t chunkLen = std::min(len, s_messageMaxLen);
-            realLen += s_internalMessageHeaderLen + chunkLen;
-            len -= chunkLen;
+    /**
+     * Hands a batch over to the real sink, and flushes it once nothing came in for s_idleFlushDelay, or at the latest
+     * once every s_flushPeriod under a steady stream of messages. Called by the sink's task or by the LogWorker.
+     * @return See LogWorkerBase::Client::serve.
+     */
+    TickType_t serve() override
+    {
+        reportDroppedMessages();
+
+        const std::uint64_t busySince = Logger::now();
+        const std::size_t   drained   = drainBatch();
+        const TickType_t    now       = xTaskGetTickCount();
+        if (drained != 0) {
+            m_lastDrained = now;
+            if (!m_flushPending) {
+                m_flushPending = true;
+                m_pendingSince = now;
+            }
         }
 
-        return realLen;
+        // More to drain if the batch was full.
+        TickType_t wait = drained == s_batchMaxCount ? 0 : portMAX_DELAY;
+        if (m_flushPending) {
+            const TickType_t idleFor    = now - m_lastDrained;
+            const TickType_t pendingFor = now - m_pendingSince;
+            if ((wait != 0 && idleFor >= s_idleFlushDelay) || pendingFor >= s_flushPeriod) {
+                m_sink.flush();
+                m_flushPending = false;
+            }
+            else if (wait != 0) {
+                wait = std::min(s_idleFlushDelay - idleFor, s_flushPeriod - pendingFor);
+            }
+        }
+        Sink::stats().busyMicroseconds.add(toMicroseconds(Logger::now() - busySince));
+        return wait;
     }
 
     [[noreturn]] static void task(void* args)
     {
         configASSERT(args != nullptr);
 
-        auto& that           = *reinterpret_cast<MtSink*>(args);
+        auto& that = *reinterpret_cast<MtSink*>(args);
+        // m_task is set by the constructor, possibly after we start running. Nobody notifies us before it returns: the
+        // sink isn't added to the Logger yet.
         that.m_taskIsRunning = true;
         vTaskPrioritySet(nullptr, s_taskPriority);
 
-        enum class States : std::uint8_t { ReceiveHeader = 0, ReceiveChunks };
-        States currentState = States::ReceiveHeader;
-
-        MessageHeader currentHeader = {};
-        auto          receiveHeader = [&] -> bool {
-            if (that.m_messagesDropped != 0) {
-                char        msg[30];
-                std::size_t len = std::snprintf(&msg[0], sizeof(msg), "Dropped %d messages!", that.m_messagesDropped);
-                that.onWriteImpl(Level::error, &msg[0], len);
-                that.m_messagesDropped = 0;
-            }
-
-            // If we haven't received anything, we're good, keep waiting for a header.
-            // If we've received something that isn't a header, we fucked up, so wait for the next thing that *looks*
-            // like a header.
-            return xMessageBufferReceive(
-                     that.m_messageBuffer, &currentHeader, sizeof(currentHeader), s_taskRefreshPeriod) ==
-                   sizeof(currentHeader);
-        };
-
-        auto receiveChunk = [&] -> bool {
-            char        rxBuff[s_messageMaxLen];
-            std::size_t received =
-              xMessageBufferReceive(that.m_messageBuffer, &rxBuff[0], s_messageMaxLen, s_taskRefreshPeriod);
-            if (received > currentHeader.len) {
-                // Uh oh, we might have received something not related to the current message!!
-                // Return in ReceiveHeader mode, to resync.
-                return true;
-            }
-
-            that.m_sink.onWrite(currentHeader.level, &rxBuff[0], received);
-            currentHeader.len -= received;
-            return currentHeader.len == 0;    // When length is 0, there's no more chunks to be received.
-        };
-
         while (that.m_taskShouldRun) {
-            bool shouldSwitchState = false;
-            switch (currentState) {
-                case States::ReceiveHeader: shouldSwitchState = receiveHeader(); break;
-                case States::ReceiveChunks: shouldSwitchState = receiveChunk(); break;
-            }
-            if (shouldSwitchState) {
-                if (currentState == States::ReceiveHeader) { currentState = States::ReceiveChunks; }
-                else {
-                    currentState = States::ReceiveHeader;
-                }
-            }
+            // Sleep until a producer queues something or the sink has to be flushed, not at all if there's more to do.
+            const TickType_t wait = that.serve();
+            if (wait != 0) { ulTaskNotifyTake(pdTRUE, wait); }
         }
+        that.m_sink.flush();
 
         that.m_taskIsRunning = false;
         // `that` is now dangling, do not use it anymore!
+#if LOGGER_STATIC_CONFIG
+        // The destructor deletes us, our stack and TCB belong to `that`.
+        while (true) {
+            vTaskDelay(portMAX_DELAY);
+        }
+#else
         vTaskDelete(nullptr);
         std::unreachable();
+#endif
     }
 };
 }    // namespace Logging
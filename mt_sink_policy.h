@@ -0,0 +1,96 @@
+/**
+ * @file    mt_sink_policy.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Tuning of MtSink: overflow behavior, reserved room, task parameters.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef VENDOR_LOGGING_MT_SINK_POLICY_H
+#define VENDOR_LOGGING_MT_SINK_POLICY_H
+
+#include <FreeRTOS.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Logging {
+//! What an MtSink does with a message that doesn't fit in its ring, see MtSinkPolicy::overflow.
+enum class OverflowStrategy : std::uint8_t {
+    /**
+     * Tasks wait for room for up to MtSinkPolicy::blockTime, then drop the message. Nothing is lost while the sink
+     * keeps up on average, but the producers are slowed down to the pace of the transport during a burst.
+     */
+    block,
+    /**
+     * The message is dropped right away. The producers never wait, the end of a burst is lost.
+     */
+    dropNewest,
+    /**
+     * The oldest queued messages are discarded to make room, errors and warnings excepted, which are delivered instead.
+     * Tasks wait for the sink's task to discard them, for up to MtSinkPolicy::blockTime: about the time it takes to
+     * finish the batch being written. Interrupts drop their message, but the room is made for the next ones. The
+     * start of a burst is lost.
+     */
+    dropOldest,
+    /**
+     * Once the ring is more than MtSinkPolicy::samplePercent full, only one in MtSinkPolicy::sampleRate info, debug
+     * and trace messages is queued. The producers never wait and a burst leaves a trace of its whole length, the
+     * messages that still don't fit are dropped.
+     */
+    sample,
+};
+
+/**
+ * Default tuning of MtSink. To change some of the parameters, derive from it and shadow them:
+ * ```cpp
+ * struct LossyPolicy : Logging::MtSinkPolicy {
+ *     static constexpr auto        overflow      = Logging::OverflowStrategy::dropOldest;
+ *     static constexpr std::size_t reservedBytes = 256;
+ * };
+ * using LossyUartSink = Logging::MtSink<Logging::UartSink, 2048, Logging::MpscRing, LossyPolicy>;
+ * ```
+ */
+struct MtSinkPolicy {
+    static constexpr OverflowStrategy overflow = OverflowStrategy::block;
+    //! Longest time (in ticks) a task waits for room, with OverflowStrategy::block and OverflowStrategy::dropOldest.
+    static constexpr TickType_t blockTime = portMAX_DELAY;
+    /**
+     * Bytes of the ring (of each lane, with a LanedRing) that only errors and warnings can use, so that they still get
+     * through when the other levels flood the ring.
+     */
+    static constexpr std::size_t reservedBytes = 0;
+    //! How full the ring is before OverflowStrategy::sample kicks in, in percent of the room of the other levels.
+    static constexpr std::size_t samplePercent = 50;
+    //! One message in sampleRate is kept while sampling.
+    static constexpr std::uint32_t sampleRate = 8;
+
+    //! Longest message queued, longer ones are dropped. Capped to what the ring can hold.
+    static constexpr std::size_t messageMaxLength = SIZE_MAX;
+    //! Maximum number of messages handed over to the real sink in a single batch, they are kept on the task's stack.
+    static constexpr std::size_t batchMaxCount = 16;
+    //! Room left on the task's stack for the real sink, in bytes.
+    static constexpr std::size_t sinkStackSize = 128;
+    //! Priority of the task, low by default.
+    static constexpr UBaseType_t taskPriority = 1;
+    /**
+     * When true, the sink doesn't have a task of its own: it is drained by the LogWorker given to its constructor,
+     * along with other sinks, which saves a stack per sink. taskPriority and sinkStackSize are then set by the worker.
+     */
+    static constexpr bool sharedWorker = false;
+};
+//! MtSinkPolicy for the sinks drained by a LogWorker.
+struct SharedWorkerPolicy : MtSinkPolicy {
+    static constexpr bool sharedWorker = true;
+};
+}    // namespace Logging
+
+#endif    // VENDOR_LOGGING_MT_SINK_POLICY_H
@@ -0,0 +1,71 @@
+/**
+ * @file    mt_sink_tracer.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Instrumentation hooks of MtSink.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#ifndef VENDOR_LOGGING_MT_SINK_TRACER_H
+#define VENDOR_LOGGING_MT_SINK_TRACER_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Logging {
+/**
+ * Receives the life of every message going through an MtSink, to measure latencies, drops and ordering under load and
+ * size the queue from data.
+ *
+ * Only available with LOGGER_MT_SINK_TRACING set to 1, which adds a sequence number and a timestamp to every queued
+ * message. Every message gets a sequence number when it is submitted, so a number that is neither delivered nor
+ * reported dropped is a lost message. Concurrent producers can be delivered out of sequence, the messages of a single
+ * producer must never be.
+ *
+ * The producer hooks are called from the producers' context, interrupts included, and must be safe there. The delivery
+ * hook is called from the MtSink's task.
+ */
+class MtSinkTracer {
+public:
+    virtual ~MtSinkTracer() = default;
+
+    //! Clock of every timestamp given to the hooks, e.g. Logger::now.
+    virtual std::uint64_t now() = 0;
+
+    /**
+     * A message was queued.
+     * @param enqueueTicks When it was committed to the queue.
+     * @param producerTicks How long the producer spent in the MtSink, waiting for room included. For messages
+     * formatted in place, the formatting is included.
+     */
+    virtual void onEnqueued(std::uint32_t /*sequence*/, std::uint64_t /*enqueueTicks*/, std::uint64_t /*producerTicks*/)
+    {
+    }
+
+    //! A message was dropped, for lack of room or because it was too long.
+    virtual void onDropped(std::uint32_t /*sequence*/, bool /*fromIsr*/) {}
+
+    /**
+     * The task handed a message over to the real sink.
+     * @param string The message as delivered, to check its integrity.
+     */
+    virtual void onDelivered(std::uint32_t /*sequence*/,
+                             std::uint64_t /*enqueueTicks*/,
+                             std::uint64_t /*deliveredTicks*/,
+                             const char* /*string*/,
+                             std::size_t /*length*/)
+    {
+    }
+};
+}    // namespace Logging
+
+#endif    // VENDOR_LOGGING_MT_SINK_TRACER_H
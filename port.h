@@ -0,0 +1,78 @@
+/**
+ * @file    port.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Bits of the logger that depend on the FreeRTOS port.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#ifndef VENDOR_LOGGING_PORT_H
+#define VENDOR_LOGGING_PORT_H
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <cstdint>
+
+namespace Logging::Port {
+/**
+ * Whether the caller is an interrupt handler, i.e. must use the FromISR variants of the FreeRTOS API.
+ *
+ * Reads the active exception number on Cortex-M. Ports without that register, like the POSIX port used for host builds,
+ * never run the logger from an interrupt.
+ */
+inline bool isInIsr()
+{
+#ifdef portNVIC_INT_CTRL_REG
+    return (portNVIC_INT_CTRL_REG & 0x1FF) != 0;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Priority of the running interrupt, as given to HAL_NVIC_SetPriority with every bit for the preemption priority as
+ * FreeRTOS requires. Interrupts of the same priority never preempt each other. Only meaningful when isInIsr is true,
+ * the faults of fixed priority give 0.
+ *
+ * Reads the NVIC or SCB priority register of the active exception on Cortex-M, with configPRIO_BITS telling how many of
+ * its bits are implemented.
+ */
+inline std::uint8_t interruptPriority()
+{
+#if defined(LOGGER_HOST_INTERRUPT_PRIORITY)
+    return LOGGER_HOST_INTERRUPT_PRIORITY;
+#elif defined(portNVIC_INT_CTRL_REG) && defined(configPRIO_BITS)
+    const std::uint32_t exception = portNVIC_INT_CTRL_REG & 0x1FF;
+    std::uint8_t        priority  = 0;
+    if (exception >= 16) {
+        // NVIC_IPR, a byte per external interrupt.
+        priority = *reinterpret_cast<volatile std::uint8_t*>(0xE000E400 + (exception - 16));
+    }
+    else if (exception >= 4) {
+        // SCB_SHPR, a byte per system exception from MemManage on.
+        priority = *reinterpret_cast<volatile std::uint8_t*>(0xE000ED18 + (exception - 4));
+    }
+    return static_cast<std::uint8_t>(priority >> (8 - configPRIO_BITS));
+#else
+    return 0;
+#endif
+}
+
+//! Lets the lower priority tasks run for a tick. Tasks only.
+inline void delayTick()
+{
+    vTaskDelay(1);
+}
+}    // namespace Logging::Port
+
+#endif    // VENDOR_LOGGING_PORT_H
@@ -0,0 +1,35 @@
+/**
+ * @file    posix_clock.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Nanosecond log timestamps for host builds.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#ifndef VENDOR_LOGGING_POSIX_CLOCK_H
+#define VENDOR_LOGGING_POSIX_CLOCK_H
+
+#include <cstdint>
+
+namespace Logging {
+/**
+ * CLOCK_MONOTONIC, in nanoseconds. For host builds, see Logger::setClock.
+ */
+class PosixClock {
+public:
+    static std::uint64_t now();
+
+    static constexpr std::uint64_t ticksPerSecond() { return 1'000'000'000; }
+};
+}    // namespace Logging
+
+#endif    // VENDOR_LOGGING_POSIX_CLOCK_H
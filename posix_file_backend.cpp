@@ -0,0 +1,75 @@
+/**
+ * @file    posix_file_backend.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#include "posix_file_backend.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+
+namespace Logging {
+bool PosixFileBackend::open(const char* path)
+{
+    close();
+    m_fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    return m_fd >= 0;
+}
+
+void PosixFileBackend::close()
+{
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+bool PosixFileBackend::write(const char* data, std::size_t length)
+{
+    while (length != 0) {
+        ssize_t written = ::write(m_fd, data, length);
+        if (written < 0) {
+            if (errno == EINTR) { continue; }
+            return false;
+        }
+        data += written;
+        length -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+bool PosixFileBackend::seek(std::size_t offset)
+{
+    return ::lseek(m_fd, static_cast<off_t>(offset), SEEK_SET) >= 0;
+}
+
+bool PosixFileBackend::sync()
+{
+    return ::fsync(m_fd) == 0;
+}
+
+bool PosixFileBackend::rename(const char* from, const char* to)
+{
+    return std::rename(from, to) == 0;
+}
+
+void PosixFileBackend::remove(const char* path)
+{
+    ::unlink(path);
+}
+}    // namespace Logging
@@ -0,0 +1,45 @@
+/**
+ * @file    posix_file_backend.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   POSIX implementation of the file sink's filesystem, for hosts.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#ifndef VENDOR_LOGGING_POSIX_FILE_BACKEND_H
+#define VENDOR_LOGGING_POSIX_FILE_BACKEND_H
+
+#include "file_backend.h"
+
+namespace Logging {
+class PosixFileBackend : public FileBackend {
+    int m_fd = -1;
+
+public:
+    PosixFileBackend() = default;
+    PosixFileBackend(const PosixFileBackend&)            = delete;
+    PosixFileBackend(PosixFileBackend&&)                 = delete;
+    PosixFileBackend& operator=(const PosixFileBackend&) = delete;
+    PosixFileBackend& operator=(PosixFileBackend&&)      = delete;
+    ~PosixFileBackend() override { close(); }
+
+    bool open(const char* path) override;
+    void close() override;
+    bool write(const char* data, std::size_t length) override;
+    bool seek(std::size_t offset) override;
+    bool sync() override;
+    bool rename(const char* from, const char* to) override;
+    void remove(const char* path) override;
+};
+}    // namespace Logging
+
+#endif    // VENDOR_LOGGING_POSIX_FILE_BACKEND_H
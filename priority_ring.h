@@ -0,0 +1,168 @@
+/**
+ * @file    priority_ring.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Set of rings drained by severity, so that errors overtake the queued traces.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef VENDOR_LOGGING_PRIORITY_RING_H
+#define VENDOR_LOGGING_PRIORITY_RING_H
+
+#include "level.h"
+#include "mpsc_ring.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Logging {
+/**
+ * Set of rings with the same interface as MpscRing, with a lane per group of levels. The consumer always reads the
+ * most severe lane that holds a record, so an error doesn't wait for the traces queued before it to go out over a slow
+ * transport, and a flood of traces can't take the room of the errors.
+ *
+ * The levels are grouped by the Boundaries: lane 0 holds the levels up to the first boundary, lane 1 the levels up to
+ * the second one, and so on, the last lane holding the rest. For example, `PriorityRing<1024, Level::error,
+ * Level::warning>` has a lane for the errors, one for the warnings and one for the other levels.
+ *
+ * The records are delivered out of order across lanes, so every record is numbered when it is reserved, see
+ * Record::sequence. The order within a lane is always kept.
+ *
+ * @tparam Capacity Size of each lane in bytes, must be a power of two. Each record takes 4 more bytes for its number.
+ * @tparam Boundaries Most verbose level of each lane but the last, in increasing order.
+ */
+template<std::size_t Capacity, Level... Boundaries>
+class PriorityRing {
+    using Lane = MpscRing<Capacity>;
+
+    static_assert(sizeof...(Boundaries) != 0, "At least one boundary is needed to get two lanes");
+
+    static constexpr Level       s_boundaries[] = {Boundaries...};
+    static constexpr std::size_t s_laneCount    = sizeof...(Boundaries) + 1;
+    static constexpr std::size_t s_sequenceSize = sizeof(std::uint32_t);
+
+    static_assert(std::ranges::is_sorted(s_boundaries) &&
+                    std::ranges::adjacent_find(s_boundaries) == std::ranges::end(s_boundaries),
+                  "The boundaries must be in increasing order");
+
+    Lane                       m_lanes[s_laneCount];
+    std::atomic<std::uint32_t> m_sequence = 0;
+
+public:
+    struct Record {
+        const char*   data     = nullptr;
+        std::size_t   length   = 0;
+        std::uint32_t sequence = 0;    //!< Order in which the record was reserved, across all the lanes.
+    };
+
+    static constexpr std::size_t s_maxLength = Lane::s_maxLength - s_sequenceSize;
+
+    /**
+     * See MpscRing::reserve, `limit` applies to the lane of the level.
+     * @param level Level of the message, which selects the lane.
+     */
+    char* reserve(Level level, std::size_t length, std::size_t limit = Capacity)
+    {
+        if (length > s_maxLength) { return nullptr; }
+        char* data = m_lanes[laneFor(level)].reserve(s_sequenceSize + length, limit);
+        if (data == nullptr) { return nullptr; }
+
+        const std::uint32_t sequence = m_sequence.fetch_add(1, std::memory_order_relaxed);
+        std::memcpy(data, &sequence, sizeof(sequence));
+        return data + s_sequenceSize;
+    }
+
+    //! Number of a record returned by reserve, the same as its Record::sequence.
+    static std::uint32_t sequenceOf(const char* data)
+    {
+        std::uint32_t sequence;
+        std::memcpy(&sequence, data - s_sequenceSize, sizeof(sequence));
+        return sequence;
+    }
+
+    //! See MpscRing::commit.
+    void commit(char* data)
+    {
+        char* record = data - s_sequenceSize;
+        laneOf(record).commit(record);
+    }
+
+    //! See MpscRing::commit.
+    void commit(char* data, std::size_t length)
+    {
+        char* record = data - s_sequenceSize;
+        laneOf(record).commit(record, s_sequenceSize + length);
+    }
+
+    //! See MpscRing::used, for all the lanes.
+    std::size_t used() const
+    {
+        std::size_t used = 0;
+        for (const auto& lane : m_lanes) {
+            used += lane.used();
+        }
+        return used;
+    }
+
+    //! See MpscRing::read, the record at the front of the most severe lane that has one is read.
+    bool read(Record& record)
+    {
+        for (auto& lane : m_lanes) {
+            typename Lane::Record front;
+            if (!lane.read(front)) { continue; }
+
+            record = {front.data + s_sequenceSize, front.length - s_sequenceSize};
+            std::memcpy(&record.sequence, front.data, sizeof(record.sequence));
+            return true;
+        }
+        return false;
+    }
+
+    //! See MpscRing::release.
+    void release()
+    {
+        for (auto& lane : m_lanes) {
+            lane.release();
+        }
+    }
+
+private:
+    static constexpr std::size_t laneFor(Level level)
+    {
+        std::size_t lane = 0;
+        while (lane < s_laneCount - 1 && level > s_boundaries[lane]) {
+            lane++;
+        }
+        return lane;
+    }
+
+    Lane& laneOf(const char* record)
+    {
+        const auto offset = static_cast<std::size_t>(record - reinterpret_cast<const char*>(&m_lanes[0]));
+        return m_lanes[offset / sizeof(Lane)];
+    }
+};
+
+/**
+ * Adapts PriorityRing to the Queue parameter of MtSink, e.g. `MtSink<UartSink, 1024, Priorities<Level::warning>::Ring>`
+ * gives the errors and warnings a 1024 bytes lane that is always drained first, and the other levels another one.
+ */
+template<Level... Boundaries>
+struct Priorities {
+    template<std::size_t Capacity>
+    using Ring = PriorityRing<Capacity, Boundaries...>;
+};
+}    // namespace Logging
+
+#endif    // VENDOR_LOGGING_PRIORITY_RING_H
@@ -35,7 +35,14 @@ public:
     ProxySink& operator=(ProxySink&&)      = default;
     ~ProxySink() override                  = default;
 
+    SinkStats&          stats() override { return m_sink->stats(); }
+    SinkStats::Snapshot snapshotStats() const override { return m_sink->snapshotStats(); }
+
     void onWrite(Level level, const char* string, size_t length) override { m_sink->onWrite(level, string, length); }
+    void  onWriteBatch(const Message* messages, size_t count) override { m_sink->onWriteBatch(messages, count); }
+    void  flush() override { m_sink->flush(); }
+    char* reserve(Level level, size_t maxLength) override { return m_sink->reserve(level, maxLength); }
+    void  commit(char* buffer, size_t length) override { m_sink->commit(buffer, length); }
 };
 
 }    // namespace Logging
@@ -0,0 +1,180 @@
+/**
+ * @file    retained_ram_sink.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#include "retained_ram_sink.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+
+namespace Logging {
+namespace {
+//! CRC-32 (IEEE 802.3), a nibble at a time: a 64 bytes table is enough.
+std::uint32_t crc32(std::uint32_t crc, const void* data, std::size_t length)
+{
+    static constexpr std::uint32_t s_table[16] = {
+      0x00000000,
+      0x1DB71064,
+      0x3B6E20C8,
+      0x26D930AC,
+      0x76DC4190,
+      0x6B6B51F4,
+      0x4DB26158,
+      0x5005713C,
+      0xEDB88320,
+      0xF00F9344,
+      0xD6D6A3E8,
+      0xCB61B38C,
+      0x9B64C2B0,
+      0x86D3D2D4,
+      0xA00AE278,
+      0xBDBDF21C,
+    };
+
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    crc               = ~crc;
+    for (std::size_t i = 0; i < length; i++) {
+        crc = s_table[(crc ^ bytes[i]) & 0x0F] ^ (crc >> 4);
+        crc = s_table[(crc ^ (bytes[i] >> 4)) & 0x0F] ^ (crc >> 4);
+    }
+    return ~crc;
+}
+}    // namespace
+
+RetainedRamSink::RetainedRamSink(void* region, std::size_t size, std::size_t slotSize)
+: m_header(static_cast<RegionHeader*>(region)),
+  m_slots(static_cast<char*>(region) + sizeof(RegionHeader)),
+  m_slotSize(slotSize),
+  m_slotCount((size - sizeof(RegionHeader)) / slotSize)
+{
+    assert(reinterpret_cast<std::uintptr_t>(region) % alignof(RegionHeader) == 0 && "Region must be aligned");
+    assert(slotSize > sizeof(SlotHeader) && slotSize % alignof(SlotHeader) == 0 && "Invalid slot size");
+    assert(size >= sizeof(RegionHeader) + slotSize && "Region too small");
+
+    if (m_header->magic != s_magic || m_header->slotSize != m_slotSize || m_header->slotCount != m_slotCount ||
+        m_header->nextSequence == 0) {
+        clear();
+    }
+}
+
+void RetainedRamSink::onWrite(Level level, const char* string, std::size_t length)
+{
+    const std::size_t room  = m_slotSize - sizeof(SlotHeader);
+    const std::size_t parts = std::max<std::size_t>((length + room - 1) / room, 1);
+    if (length > s_maxLength || parts > m_slotCount) {
+        stats().drop(DropCause::tooLong);
+        return;
+    }
+
+    const auto          count = static_cast<std::uint32_t>(parts);
+    const std::uint32_t first = std::atomic_ref {m_header->nextSequence}.fetch_add(count, std::memory_order_relaxed);
+    if (first == 0 || first + count - 1 < first) {
+        // The sequence wrapped around, 0 marks the slots being written.
+        return;
+    }
+
+    for (std::uint32_t part = 0; part < count; part++) {
+        const std::uint32_t sequence = first + part;
+        SlotHeader&         slot     = slotAt(sequence);
+        std::atomic_ref {slot.sequence}.store(0, std::memory_order_relaxed);
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+
+        const std::size_t  offset       = part * room;
+        const std::uint8_t continuation = part == 0 ? 0 : s_continuation;
+        const std::uint8_t continued    = part + 1 == count ? 0 : s_continued;
+        slot.length                     = static_cast<std::uint16_t>(std::min(length - offset, room));
+        slot.level                      = level;
+        slot.flags                      = continuation | continued;
+        std::memcpy(&slot + 1, string + offset, slot.length);
+        slot.crc = computeCrc(slot, sequence);
+
+        std::atomic_ref {slot.sequence}.store(sequence, std::memory_order_release);
+    }
+}
+
+std::size_t RetainedRamSink::replay(Sink& sink) const
+{
+    const std::uint32_t next  = std::atomic_ref {m_header->nextSequence}.load(std::memory_order_relaxed);
+    const std::uint32_t first = next > m_slotCount ? next - m_slotCount : 1;
+
+    // The parts of a message taking several slots are put back together here. A message missing a part is skipped.
+    char        message[s_maxLength];
+    std::size_t messageLength = 0;
+    bool        assembling    = false;
+
+    std::size_t replayed = 0;
+    for (std::uint32_t sequence = first; sequence != next; sequence++) {
+        if (!isIntact(sequence)) {
+            // Overwritten, torn by a reset or never written.
+            assembling = false;
+            continue;
+        }
+        const SlotHeader& slot = slotAt(sequence);
+        const char*       data = reinterpret_cast<const char*>(&slot + 1);
+        if ((slot.flags & (s_continued | s_continuation)) == 0) {
+            assembling = false;
+            sink.onWrite(slot.level, data, slot.length);
+            replayed++;
+            continue;
+        }
+
+        if ((slot.flags & s_continuation) == 0) {
+            assembling    = true;
+            messageLength = 0;
+        }
+        if (!assembling || messageLength + slot.length > sizeof(message)) {
+            // The first parts were lost.
+            assembling = false;
+            continue;
+        }
+        std::memcpy(&message[messageLength], data, slot.length);
+        messageLength += slot.length;
+        if ((slot.flags & s_continued) == 0) {
+            assembling = false;
+            sink.onWrite(slot.level, &message[0], messageLength);
+            replayed++;
+        }
+    }
+    return replayed;
+}
+
+bool RetainedRamSink::isIntact(std::uint32_t sequence) const
+{
+    const SlotHeader& slot = slotAt(sequence);
+    return std::atomic_ref {const_cast<SlotHeader&>(slot).sequence}.load(std::memory_order_acquire) == sequence &&
+           slot.length <= m_slotSize - sizeof(SlotHeader) && slot.crc == computeCrc(slot, sequence);
+}
+
+void RetainedRamSink::clear()
+{
+    std::memset(m_slots, 0, m_slotCount * m_slotSize);
+    m_header->magic        = s_magic;
+    m_header->slotSize     = static_cast<std::uint32_t>(m_slotSize);
+    m_header->slotCount    = static_cast<std::uint32_t>(m_slotCount);
+    m_header->nextSequence = 1;
+}
+
+std::uint32_t RetainedRamSink::computeCrc(const SlotHeader& slot, std::uint32_t sequence)
+{
+    std::uint32_t crc = crc32(0, &sequence, sizeof(sequence));
+    crc               = crc32(crc, &slot.length, sizeof(slot.length));
+    crc               = crc32(crc, &slot.level, sizeof(slot.level));
+    crc               = crc32(crc, &slot.flags, sizeof(slot.flags));
+    return crc32(crc, &slot + 1, slot.length);
+}
+}    // namespace Logging
@@ -0,0 +1,113 @@
+/**
+ * @file    retained_ram_sink.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Sink keeping the last messages in RAM that survives a reset.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#ifndef VENDOR_LOGGING_RETAINED_RAM_SINK_H
+#define VENDOR_LOGGING_RETAINED_RAM_SINK_H
+
+#include "sink.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Logging {
+/**
+ * Keeps the last messages in a region of RAM that isn't cleared at reset (e.g. `.noinit`), so that they can be replayed
+ * after a crash or a watchdog reset.
+ *
+ * The region is split in fixed-size slots, used round-robin. Each record carries a sequence number and a CRC, so that a
+ * record torn by a reset is detected and skipped. Writing a record is lock-free and safe from interrupts; it costs a
+ * copy and a CRC, no formatting. A message longer than a slot takes several consecutive ones, and is only replayed if
+all of them survived.
+ *
+ * The region is only initialized if it doesn't already hold a valid header with the same geometry.
+ *
+ * @attention Requires a lock-free fetch-and-add, i.e. not Cortex-M0.
+ */
+class RetainedRamSink : public Sink {
+public:
+    static constexpr std::size_t s_defaultSlotSize = 128;
+    //! Longest message kept, Logger::s_maxLength. Longer ones, or ones that would take every slot, are dropped.
+    static constexpr std::size_t s_maxLength = 512;
+
+private:
+    static constexpr std::uint32_t s_magic = 0x4C4F4732;    // "LOG2"
+
+    //! Flags of a slot.
+    static constexpr std::uint8_t s_continued    = 0x01;    //!< The message goes on in the next slot.
+    static constexpr std::uint8_t s_continuation = 0x02;    //!< The slot goes on with the message of the previous one.
+
+    struct RegionHeader {
+        std::uint32_t magic;
+        std::uint32_t slotSize;
+        std::uint32_t slotCount;
+        std::uint32_t nextSequence;    //!< Sequence number of the next slot written, the first one is 1.
+    };
+
+    struct SlotHeader {
+        std::uint32_t sequence;    //!< 0 while the slot is being written.
+        std::uint32_t crc;         //!< Of the sequence, the length, the level, the flags and the data.
+        std::uint16_t length;
+        Level         level;
+        std::uint8_t  flags;
+    };
+
+    RegionHeader* m_header;
+    char*         m_slots;
+    std::size_t   m_slotSize;
+    std::size_t   m_slotCount;
+
+public:
+    /**
+     * @param region Retained memory, aligned on 4 bytes. Its content is kept if it was written by a sink of the same
+     * geometry.
+     * @param size Size of the region, in bytes.
+     * @param slotSize Size of a slot, header included. Longer messages take several slots.
+     */
+    RetainedRamSink(void* region, std::size_t size, std::size_t slotSize = s_defaultSlotSize);
+    RetainedRamSink(const RetainedRamSink&)            = delete;
+    RetainedRamSink(RetainedRamSink&&)                 = delete;
+    RetainedRamSink& operator=(const RetainedRamSink&) = delete;
+    RetainedRamSink& operator=(RetainedRamSink&&)      = delete;
+
+    ~RetainedRamSink() override = default;
+
+    void onWrite(Level level, const char* string, std::size_t length) override;
+
+    /**
+     * Sends the surviving messages to another sink, oldest first.
+     * @return The number of messages replayed.
+     */
+    std::size_t replay(Sink& sink) const;
+
+    //! Forgets every record.
+    void clear();
+
+private:
+    SlotHeader& slotAt(std::uint32_t sequence) const
+    {
+        return *reinterpret_cast<SlotHeader*>(m_slots + (sequence % m_slotCount) * m_slotSize);
+    }
+
+    //! Whether the slot of that sequence number holds an intact record of it.
+    bool isIntact(std::uint32_t sequence) const;
+
+    static std::uint32_t computeCrc(const SlotHeader& slot, std::uint32_t sequence);
+};
+
+}    // namespace Logging
+
+#endif    // VENDOR_LOGGING_RETAINED_RAM_SINK_H
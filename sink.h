@@ -17,17 +17,85 @@
 #ifndef SINK_H
 #define SINK_H
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 
 #include "level.h"
+#include "stats.h"
 
 namespace Logging {
 
 class Sink {
+  //! Changed at any time while the other tasks log, only its own value matters.
+  std::atomic<Level> m_level = Level::all;
+  SinkStats m_stats;
+
  public:
+  //! A message of a batch, see onWriteBatch.
+  struct Message {
+    Level level;
+    const char* string;
+    std::size_t length;
+    //! Order in which the message was queued, when the queue numbers its messages and may deliver them out of order.
+    std::uint32_t sequence = 0;
+  };
+
   virtual ~Sink() = default;
 
+  /**
+   * Sets the most verbose level this sink wants, on top of the level of the logger. For example, a RAM capture can take
+   * everything while the UART console only gets the info messages. Defaults to Level::all.
+   */
+  void setLevel(Level level) { m_level.store(level, std::memory_order_relaxed); }
+  [[nodiscard]] Level getLevel() const { return m_level.load(std::memory_order_relaxed); }
+  [[nodiscard]] bool accepts(Level level) const { return level <= getLevel(); }
+
+  /**
+   * Counters of the sink. A sink that forwards to another one (e.g. ProxySink) returns the other one's, so that they
+   * are all counted in the same place.
+   */
+  virtual SinkStats& stats() { return m_stats; }
+
+  /**
+   * Reads the counters. Sinks wrapping another sink (e.g. MtSink) add the drops of the wrapped one.
+   */
+  [[nodiscard]] virtual SinkStats::Snapshot snapshotStats() const { return m_stats.snapshot(); }
+
   virtual void onWrite(Level level, const char* string, std::size_t length) = 0;
+
+  /**
+   * Writes several messages at once, letting the sink group them into fewer transfers.
+   *
+   * The default implementation calls onWrite for each message.
+   */
+  virtual void onWriteBatch(const Message* messages, std::size_t count) {
+    for (std::size_t i = 0; i < count; i++) {
+      onWrite(messages[i].level, messages[i].string, messages[i].length);
+    }
+  }
+
+  /**
+   * Sends whatever the sink kept buffered. Called by MtSink once its queue has been idle for a short while.
+   */
+  virtual void flush() {}
+
+  /**
+   * Optional zero-copy path: lends a buffer of at least maxLength bytes where the message can be written in place,
+   * saving the copy made by onWrite. Every successful reserve must be followed by a commit.
+   *
+   * @return The buffer, or nullptr if the sink doesn't support it or has no room. onWrite is used instead then.
+   */
+  virtual char* reserve(Level /*level*/, std::size_t /*maxLength*/) { return nullptr; }
+
+  /**
+   * Publishes a message written in a buffer obtained from reserve.
+   *
+   * @param buffer The buffer returned by reserve.
+   * @param length Length of the message. Only the byte following it (e.g. a null terminator) may have been written
+   * past it.
+   */
+  virtual void commit(char* /*buffer*/, std::size_t /*length*/) {}
 };
 
 }  // namespace Logging
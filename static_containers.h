@@ -0,0 +1,133 @@
+/**
+ * @file    static_containers.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Fixed-capacity containers for the heap-free configuration.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef VENDOR_LOGGING_STATIC_CONTAINERS_H
+#define VENDOR_LOGGING_STATIC_CONTAINERS_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+namespace Logging {
+/**
+ * Vector with a fixed capacity and inline storage, never allocating. Used instead of std::vector when
+ * LOGGER_STATIC_CONFIG is set.
+ *
+ * Only the subset of std::vector used by the logger is provided. The elements must be default constructible.
+ */
+template<typename T, std::size_t Capacity>
+class StaticVector {
+    std::array<T, Capacity> m_data = {};
+    std::size_t             m_size = 0;
+
+public:
+    using value_type     = T;
+    using iterator       = T*;
+    using const_iterator = const T*;
+
+    iterator       begin() { return m_data.data(); }
+    iterator       end() { return m_data.data() + m_size; }
+    const_iterator begin() const { return m_data.data(); }
+    const_iterator end() const { return m_data.data() + m_size; }
+
+    [[nodiscard]] std::size_t size() const { return m_size; }
+    [[nodiscard]] bool        empty() const { return m_size == 0; }
+    //! The capacity, so that `size() == max_size()` tells whether the vector is full, like with std::vector.
+    static constexpr std::size_t max_size() { return Capacity; }
+    //! Does nothing, the storage is already there.
+    static void reserve(std::size_t /*size*/) {}
+
+    T&       operator[](std::size_t index) { return m_data[index]; }
+    const T& operator[](std::size_t index) const { return m_data[index]; }
+    T&       back() { return m_data[m_size - 1]; }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        assert(m_size < Capacity && "StaticVector is full");
+        m_data[m_size] = T {std::forward<Args>(args)...};
+        return m_data[m_size++];
+    }
+    void push_back(const T& value) { emplace_back(value); }
+
+    iterator erase(iterator it)
+    {
+        std::move(it + 1, end(), it);
+        m_data[--m_size] = T {};
+        return it;
+    }
+
+    void clear()
+    {
+        std::fill(begin(), end(), T {});
+        m_size = 0;
+    }
+};
+
+/**
+ * Map with a fixed capacity and a linear lookup, never allocating. Used instead of std::unordered_map when
+ * LOGGER_STATIC_CONFIG is set, for a handful of entries.
+ */
+template<typename Key, typename Value, std::size_t Capacity>
+class StaticMap {
+public:
+    //! Aggregate instead of std::pair, whose constructors can't be used on the nested types of incomplete classes.
+    struct Entry {
+        Key   first;
+        Value second;
+    };
+
+private:
+    StaticVector<Entry, Capacity> m_entries;
+
+public:
+    using iterator       = typename StaticVector<Entry, Capacity>::iterator;
+    using const_iterator = typename StaticVector<Entry, Capacity>::const_iterator;
+
+    iterator       begin() { return m_entries.begin(); }
+    iterator       end() { return m_entries.end(); }
+    const_iterator begin() const { return m_entries.begin(); }
+    const_iterator end() const { return m_entries.end(); }
+
+    [[nodiscard]] std::size_t    size() const { return m_entries.size(); }
+    static constexpr std::size_t max_size() { return Capacity; }
+
+    iterator find(const Key& key)
+    {
+        return std::ranges::find_if(m_entries, [&key](const auto& entry) { return entry.first == key; });
+    }
+    const_iterator find(const Key& key) const
+    {
+        return std::ranges::find_if(m_entries, [&key](const auto& entry) { return entry.first == key; });
+    }
+    [[nodiscard]] bool contains(const Key& key) const { return find(key) != end(); }
+
+    //! Same as std::unordered_map::emplace, the map must not be full.
+    std::pair<iterator, bool> emplace(const Key& key, const Value& value)
+    {
+        auto it = find(key);
+        if (it != end()) { return {it, false}; }
+        m_entries.emplace_back(key, value);
+        return {&m_entries.back(), true};
+    }
+
+    iterator erase(iterator it) { return m_entries.erase(it); }
+};
+}    // namespace Logging
+
+#endif    // VENDOR_LOGGING_STATIC_CONTAINERS_H
@@ -0,0 +1,137 @@
+/**
+ * @file    stats.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Runtime statistics of the loggers and sinks.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef VENDOR_LOGGING_STATS_H
+#define VENDOR_LOGGING_STATS_H
+
+#include "level.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Logging {
+/**
+ * Counter that can be updated from any task or interrupt and read at any time. Updates are relaxed: a snapshot isn't
+ * consistent across counters, but every counter is exact.
+ *
+ * Counters wrap around, compare two snapshots with an unsigned subtraction to get a rate.
+ *
+ * @note Cortex-M0 has no atomic read-modify-write, the updates go through libatomic there.
+ */
+class Counter {
+    std::atomic<std::uint32_t> m_value = 0;
+
+public:
+    Counter() = default;
+    Counter(const Counter& other) : m_value(other.get()) {}
+    Counter& operator=(const Counter& other)
+    {
+        m_value.store(other.get(), std::memory_order_relaxed);
+        return *this;
+    }
+
+    void add(std::uint32_t count = 1) { m_value.fetch_add(count, std::memory_order_relaxed); }
+
+    //! Raises the counter to `value` if it is below it, for high-water marks and maximums.
+    void max(std::uint32_t value)
+    {
+        std::uint32_t current = m_value.load(std::memory_order_relaxed);
+        while (current < value && !m_value.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+
+    [[nodiscard]] std::uint32_t get() const { return m_value.load(std::memory_order_relaxed); }
+};
+
+//! Why a sink lost a message.
+enum class DropCause : std::uint8_t {
+    full,           //!< No room in the sink's queue or buffer.
+    tooLong,        //!< The message is bigger than anything the sink can queue.
+    transport,      //!< The transport failed or timed out, e.g. a USB packet that was never picked up by the host.
+    overwritten,    //!< Discarded from the queue to make room for newer messages, see OverflowStrategy::dropOldest.
+    sampled,        //!< Left out while the queue was filling up, see OverflowStrategy::sample.
+    count,
+};
+
+/**
+ * Counters of a sink. The Logger counts the messages and bytes it hands over, the sink counts the rest.
+ */
+struct SinkStats {
+    static constexpr std::size_t s_dropCauseCount = static_cast<std::size_t>(DropCause::count);
+
+    //! Plain copy of the counters, see Sink::snapshotStats.
+    struct Snapshot {
+        std::uint32_t messages                  = 0;
+        std::uint32_t bytes                     = 0;
+        std::uint32_t dropped[s_dropCauseCount] = {};
+        std::uint32_t queueHighWater            = 0;    //!< In bytes, for the sinks with a queue.
+        std::uint32_t busyMicroseconds          = 0;    //!< Time spent by the consumer task, if any.
+        std::uint32_t maxLatencyMicroseconds    = 0;    //!< From queuing to delivery, if queued.
+
+        [[nodiscard]] std::uint32_t droppedBy(DropCause cause) const { return dropped[static_cast<std::size_t>(cause)]; }
+    };
+
+    Counter messages;
+    Counter bytes;
+    Counter dropped[s_dropCauseCount];
+    Counter queueHighWater;
+    Counter busyMicroseconds;
+    Counter maxLatencyMicroseconds;
+
+    void drop(DropCause cause, std::uint32_t count = 1) { dropped[static_cast<std::size_t>(cause)].add(count); }
+
+    [[nodiscard]] Snapshot snapshot() const
+    {
+        Snapshot snapshot {.messages               = messages.get(),
+                           .bytes                  = bytes.get(),
+                           .queueHighWater         = queueHighWater.get(),
+                           .busyMicroseconds       = busyMicroseconds.get(),
+                           .maxLatencyMicroseconds = maxLatencyMicroseconds.get()};
+        for (std::size_t i = 0; i < s_dropCauseCount; i++) {
+            snapshot.dropped[i] = dropped[i].get();
+        }
+        return snapshot;
+    }
+};
+
+/**
+ * Counters of a logger, updated by the log calls.
+ */
+struct LoggerStats {
+    static constexpr std::size_t s_levelCount = static_cast<std::size_t>(Level::all) + 1;
+
+    struct Snapshot {
+        std::uint32_t messages[s_levelCount] = {};    //!< Messages logged, by level.
+        std::uint32_t filtered               = 0;     //!< Calls discarded by the level of the logger or its sinks.
+    };
+
+    Counter messages[s_levelCount];
+    Counter filtered;
+
+    void count(Level level) { messages[static_cast<std::size_t>(level)].add(); }
+
+    [[nodiscard]] Snapshot snapshot() const
+    {
+        Snapshot snapshot {.filtered = filtered.get()};
+        for (std::size_t i = 0; i < s_levelCount; i++) {
+            snapshot.messages[i] = messages[i].get();
+        }
+        return snapshot;
+    }
+};
+}    // namespace Logging
+
+#endif    // VENDOR_LOGGING_STATS_H
@@ -0,0 +1,259 @@
+/**
+ * @file    fakes.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Sinks and transports standing in for the hardware in the tests and benchmarks.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#ifndef VENDOR_LOGGING_TESTS_FAKES_H
+#define VENDOR_LOGGING_TESTS_FAKES_H
+
+#include "cdc_transport.h"
+#include "file_backend.h"
+#include "sink.h"
+#include "uart_transport.h"
+
+#include <FreeRTOS.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Logging::Fakes {
+//! Only counts what it is given, the cheapest possible sink.
+class CountingSink : public Sink {
+public:
+    std::atomic<std::size_t> messages = 0;
+    std::atomic<std::size_t> bytes    = 0;
+
+    void onWrite(Level /*level*/, const char* /*string*/, std::size_t length) override
+    {
+        messages.fetch_add(1, std::memory_order_relaxed);
+        bytes.fetch_add(length, std::memory_order_relaxed);
+    }
+};
+
+//! Keeps a copy of every message. Thread-safe.
+class RecordingSink : public Sink {
+public:
+    struct Record {
+        Level       level;
+        std::string text;
+    };
+
+    void onWrite(Level level, const char* string, std::size_t length) override
+    {
+        std::scoped_lock lock(m_lock);
+        m_records.push_back({level, std::string(string, length)});
+    }
+
+    [[nodiscard]] std::vector<Record> records() const
+    {
+        std::scoped_lock lock(m_lock);
+        return m_records;
+    }
+
+    [[nodiscard]] std::size_t size() const
+    {
+        std::scoped_lock lock(m_lock);
+        return m_records.size();
+    }
+
+private:
+    mutable std::mutex  m_lock;
+    std::vector<Record> m_records;
+};
+
+//! Lends its buffer to the logger, keeping a copy of every message.
+class LendingSink : public Sink {
+public:
+    std::size_t              reservations = 0;
+    std::vector<std::string> messages;
+
+    void onWrite(Level /*level*/, const char* string, std::size_t length) override
+    {
+        messages.emplace_back(string, length);
+    }
+
+    char* reserve(Level /*level*/, std::size_t maxLength) override
+    {
+        if (maxLength > sizeof(m_buffer)) { return nullptr; }
+        reservations++;
+        return &m_buffer[0];
+    }
+
+    void commit(char* buffer, std::size_t length) override
+    {
+        if (length != 0) { messages.emplace_back(buffer, length); }
+    }
+
+private:
+    char m_buffer[512] = {};
+};
+
+//! Takes a fixed time per message, like a slow transport, and notes when it last got an error.
+class SlowSink : public Sink {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit SlowSink(std::chrono::microseconds delay) : m_delay(delay) {}
+
+    std::atomic<std::size_t>       messages = 0;
+    std::atomic<std::size_t>       errors   = 0;
+    std::atomic<Clock::time_point> lastError {};
+
+    void onWrite(Level level, const char* /*string*/, std::size_t /*length*/) override
+    {
+        std::this_thread::sleep_for(m_delay);
+        if (level == Level::error) {
+            lastError = Clock::now();
+            errors.fetch_add(1, std::memory_order_relaxed);
+        }
+        messages.fetch_add(1, std::memory_order_release);
+    }
+
+private:
+    std::chrono::microseconds m_delay;
+};
+
+/**
+ * Records the transfers, which only complete when complete() is called, like a DMA that the test steps through.
+ */
+class FakeUartTransport : public UartTransport {
+public:
+    std::vector<std::string> transfers;
+    //! Makes startTransmit fail.
+    bool fail = false;
+    //! Set while a transfer is in progress.
+    bool busy = false;
+    //! Completes the transfers before startTransmit returns, like a very short one would.
+    bool completeInStart = false;
+
+    bool startTransmit(const char* data, std::size_t length) override
+    {
+        if (fail || busy) { return false; }
+        busy = true;
+        transfers.emplace_back(data, length);
+        if (completeInStart) { complete(); }
+        return true;
+    }
+
+    //! Completes the transfer in progress, from a simulated interrupt.
+    void complete()
+    {
+        Host::InterruptScope isr;
+        busy = false;
+        onTransmitComplete();
+    }
+};
+
+/**
+ * Bounded transmit queue. send() moves its content to `packets` as if the USB host had read it, one entry per call.
+ */
+class FakeCdcTransport : public CdcTransport {
+public:
+    std::size_t capacity = 2048;
+    //! When false, nobody reads the interface: the queue fills up and queue() starts failing.
+    bool hostReading = true;
+
+    std::string              queued;
+    std::vector<std::string> queueCalls;    //!< Data of every successful call to queue().
+    std::vector<std::string> packets;
+
+    bool queue(const char* data, std::size_t length) override
+    {
+        if (queued.size() + length > capacity) { return false; }
+        queued.append(data, length);
+        queueCalls.emplace_back(data, length);
+        return true;
+    }
+
+    void send() override
+    {
+        if (!hostReading || queued.empty()) { return; }
+        packets.push_back(std::move(queued));
+        queued.clear();
+    }
+};
+
+/**
+ * Files in memory. Every write is recorded along with its offset, to check their alignment.
+ */
+class FakeFileBackend : public FileBackend {
+public:
+    struct Write {
+        std::string path;
+        std::size_t offset;
+        std::size_t length;
+    };
+
+    std::map<std::string, std::string> files;
+    std::vector<Write>                 writes;
+    std::size_t                        syncs = 0;
+    //! Makes write() fail, without writing anything.
+    bool failWrites = false;
+
+    bool open(const char* path) override
+    {
+        m_path     = path;
+        m_position = 0;
+        files[m_path].clear();
+        return true;
+    }
+    void close() override { m_path.clear(); }
+
+    bool write(const char* data, std::size_t length) override
+    {
+        if (m_path.empty() || failWrites) { return false; }
+        std::string& file = files[m_path];
+        writes.push_back({m_path, m_position, length});
+        if (file.size() < m_position + length) { file.resize(m_position + length); }
+        file.replace(m_position, length, data, length);
+        m_position += length;
+        return true;
+    }
+    bool seek(std::size_t offset) override
+    {
+        if (m_path.empty()) { return false; }
+        m_position = offset;
+        return true;
+    }
+    bool sync() override
+    {
+        syncs++;
+        return !m_path.empty();
+    }
+
+    bool rename(const char* from, const char* to) override
+    {
+        auto it = files.find(from);
+        if (it == files.end() || files.contains(to)) { return false; }
+        files[to] = std::move(it->second);
+        files.erase(from);
+        return true;
+    }
+    void remove(const char* path) override { files.erase(path); }
+
+private:
+    std::string m_path;
+    std::size_t m_position = 0;
+};
+}    // namespace Logging::Fakes
+
+#endif    // VENDOR_LOGGING_TESTS_FAKES_H
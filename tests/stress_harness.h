@@ -0,0 +1,321 @@
+/**
+ * @file    stress_harness.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Multi-producer stress harness for MtSink, with a simulated interrupt among the producers.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef VENDOR_LOGGING_TESTS_STRESS_HARNESS_H
+#define VENDOR_LOGGING_TESTS_STRESS_HARNESS_H
+
+#include "fakes.h"
+#include "logger.h"
+#include "mt_sink_tracer.h"
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if !LOGGER_MT_SINK_TRACING
+#    error "The stress harness needs LOGGER_MT_SINK_TRACING"
+#endif
+
+namespace Logging::Stress {
+struct Config {
+    unsigned producers           = 4;
+    unsigned messagesPerProducer = 2000;
+    //! Most messages logged from the simulated interrupt, one every isrPeriod while the producers run.
+    unsigned                  isrMessages = 200;
+    std::chrono::microseconds isrPeriod {100};
+    //! The payload of each message is between these many characters, prefix excluded.
+    std::size_t minPayload = 16;
+    std::size_t maxPayload = 160;
+    //! Longest time to wait for the messages to be delivered once the producers are done.
+    std::chrono::seconds timeout {10};
+};
+
+//! In nanoseconds.
+struct Latencies {
+    std::uint64_t p50 = 0;
+    std::uint64_t p99 = 0;
+    std::uint64_t max = 0;
+};
+
+struct Result {
+    std::size_t submitted  = 0;    //!< Messages logged by the producers.
+    std::size_t delivered  = 0;
+    std::size_t dropped    = 0;    //!< Reported dropped by the MtSink, for any cause.
+    std::size_t droppedIsr = 0;    //!< Of which dropped from the simulated interrupt.
+    std::size_t lost       = 0;    //!< Neither delivered nor reported dropped.
+    std::size_t outOfOrder = 0;    //!< Delivered before an earlier message of the same producer.
+    std::size_t corrupted  = 0;    //!< Delivered with a payload that doesn't match what was logged.
+
+    Latencies producer;         //!< Time spent in the MtSink by the producers, formatting included.
+    Latencies endToEnd;         //!< From the producer entering the MtSink to the delivery to the real sink.
+    double    seconds = 0;      //!< From the first message logged to the last one delivered.
+
+    [[nodiscard]] double throughput() const { return seconds != 0 ? static_cast<double>(delivered) / seconds : 0; }
+    [[nodiscard]] double dropRate() const
+    {
+        return submitted != 0 ? static_cast<double>(dropped) / static_cast<double>(submitted) : 0;
+    }
+};
+
+namespace Detail {
+using Clock = std::chrono::steady_clock;
+
+constexpr std::uint64_t s_unset = UINT64_MAX;
+
+inline std::uint64_t nowNs()
+{
+    return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+}
+
+//! Length of the filler of a message, which varies from one message to the next.
+inline std::size_t fillerLength(const Config& config, unsigned producer, unsigned counter)
+{
+    return config.minPayload + (counter * 31 + producer * 17) % (config.maxPayload - config.minPayload + 1);
+}
+
+inline char fillerChar(unsigned producer, unsigned counter, std::size_t index)
+{
+    return static_cast<char>('a' + (producer * 7 + counter + index) % 26);
+}
+
+/**
+ * Writes the payload of a message: `<producer counter filler>`.
+ * @return Its length, without the null terminator.
+ */
+inline std::size_t makePayload(const Config& config, char* out, unsigned producer, unsigned counter)
+{
+    char* end = out;
+    *end++    = '<';
+    end       = std::to_chars(end, end + 10, producer).ptr;
+    *end++    = ' ';
+    end       = std::to_chars(end, end + 10, counter).ptr;
+    *end++    = ' ';
+    for (std::size_t i = 0; i < fillerLength(config, producer, counter); i++) {
+        *end++ = fillerChar(producer, counter, i);
+    }
+    *end++ = '>';
+    *end   = '\0';
+    return static_cast<std::size_t>(end - out);
+}
+
+/**
+ * Follows every message through the MtSink. The latencies are kept by sequence number, each slot being written by a
+ * single thread and read once the run is over.
+ */
+class Tracer : public MtSinkTracer {
+public:
+    Tracer(const Config& config, std::size_t messages)
+    : m_config(config),
+      m_producerNs(messages, s_unset),
+      m_queuedNs(messages, s_unset),
+      m_lastCounter(config.producers + 1, -1)
+    {
+    }
+
+    std::uint64_t now() override { return nowNs(); }
+
+    void onEnqueued(std::uint32_t sequence, std::uint64_t /*enqueueTicks*/, std::uint64_t producerTicks) override
+    {
+        if (sequence < m_producerNs.size()) { m_producerNs[sequence] = producerTicks; }
+    }
+
+    void onDropped(std::uint32_t /*sequence*/, bool fromIsr) override
+    {
+        if (fromIsr) { m_droppedIsr.fetch_add(1, std::memory_order_relaxed); }
+        m_dropped.fetch_add(1, std::memory_order_release);
+    }
+
+    void onDelivered(std::uint32_t sequence,
+                     std::uint64_t enqueueTicks,
+                     std::uint64_t deliveredTicks,
+                     const char*   string,
+                     std::size_t   length) override
+    {
+        if (sequence < m_queuedNs.size()) { m_queuedNs[sequence] = deliveredTicks - enqueueTicks; }
+        else {
+            m_corrupted++;
+        }
+        check({string, length});
+        m_lastDelivery.store(deliveredTicks, std::memory_order_relaxed);
+        m_delivered.fetch_add(1, std::memory_order_release);
+    }
+
+    [[nodiscard]] std::size_t delivered() const { return m_delivered.load(std::memory_order_acquire); }
+    [[nodiscard]] std::size_t dropped() const { return m_dropped.load(std::memory_order_acquire); }
+
+    //! Once every message is accounted for.
+    void fill(Result& result, std::uint64_t startNs) const
+    {
+        const std::uint64_t lastDelivery = m_lastDelivery.load(std::memory_order_relaxed);
+
+        result.delivered  = delivered();
+        result.dropped    = dropped();
+        result.droppedIsr = m_droppedIsr.load(std::memory_order_relaxed);
+        result.lost       = result.submitted - std::min(result.submitted, result.delivered + result.dropped);
+        result.outOfOrder = m_outOfOrder;
+        result.corrupted  = m_corrupted;
+        result.seconds    = lastDelivery > startNs ? static_cast<double>(lastDelivery - startNs) * 1e-9 : 0;
+
+        std::vector<std::uint64_t> producer;
+        std::vector<std::uint64_t> endToEnd;
+        for (std::size_t i = 0; i < m_producerNs.size(); i++) {
+            if (m_producerNs[i] == s_unset) { continue; }
+            producer.push_back(m_producerNs[i]);
+            if (m_queuedNs[i] != s_unset) { endToEnd.push_back(m_producerNs[i] + m_queuedNs[i]); }
+        }
+        result.producer = percentiles(producer);
+        result.endToEnd = percentiles(endToEnd);
+    }
+
+private:
+    //! Checks the payload and the order of a message, from the MtSink's task.
+    void check(std::string_view text)
+    {
+        unsigned    producer = 0;
+        unsigned    counter  = 0;
+        std::size_t begin    = text.find('<');
+        if (begin == std::string_view::npos) {
+            m_corrupted++;
+            return;
+        }
+        const char* it  = text.data() + begin + 1;
+        const char* end = text.data() + text.size();
+        auto [afterProducer, producerError] = std::from_chars(it, end, producer);
+        if (producerError != std::errc {} || afterProducer == end || *afterProducer != ' ' ||
+            producer >= m_lastCounter.size()) {
+            m_corrupted++;
+            return;
+        }
+        auto [afterCounter, counterError] = std::from_chars(afterProducer + 1, end, counter);
+        if (counterError != std::errc {} || afterCounter == end || *afterCounter != ' ') {
+            m_corrupted++;
+            return;
+        }
+
+        const std::string_view filler(afterCounter + 1, static_cast<std::size_t>(end - afterCounter - 1));
+        const std::size_t      fillerSize = fillerLength(m_config, producer, counter);
+        bool                   intact     = filler.size() == fillerSize + 3 && filler.substr(fillerSize) == ">\r\n";
+        for (std::size_t i = 0; intact && i < fillerSize; i++) {
+            intact = filler[i] == fillerChar(producer, counter, i);
+        }
+        if (!intact) {
+            m_corrupted++;
+            return;
+        }
+
+        if (static_cast<std::int64_t>(counter) <= m_lastCounter[producer]) { m_outOfOrder++; }
+        m_lastCounter[producer] = std::max<std::int64_t>(m_lastCounter[producer], counter);
+    }
+
+    static Latencies percentiles(std::vector<std::uint64_t>& values)
+    {
+        if (values.empty()) { return {}; }
+        std::ranges::sort(values);
+        return {values[(values.size() - 1) / 2], values[(values.size() - 1) * 99 / 100], values.back()};
+    }
+
+    const Config& m_config;
+
+    std::vector<std::uint64_t> m_producerNs;
+    std::vector<std::uint64_t> m_queuedNs;
+
+    std::atomic<std::size_t>   m_dropped      = 0;
+    std::atomic<std::size_t>   m_droppedIsr   = 0;
+    std::atomic<std::size_t>   m_delivered    = 0;
+    std::atomic<std::uint64_t> m_lastDelivery = 0;
+
+    // Only used by the MtSink's task.
+    std::vector<std::int64_t> m_lastCounter;
+    std::size_t               m_outOfOrder = 0;
+    std::size_t               m_corrupted  = 0;
+};
+}    // namespace Detail
+
+/**
+ * Logs config.producers threads' worth of messages, plus some from a simulated interrupt, through an MtSink of type
+ * Sink forwarding them to a CountingSink. Every message is checked on delivery.
+ * @tparam Sink An MtSink of ProxySink.
+ */
+template<typename Sink>
+Result run(const Config& config)
+{
+    const std::size_t   taskMessages = static_cast<std::size_t>(config.producers) * config.messagesPerProducer;
+    Result              result;
+    Fakes::CountingSink target;
+    Detail::Tracer      tracer {config, taskMessages + config.isrMessages};
+    std::uint64_t       startNs = 0;
+    {
+        Sink sink {&target};
+        sink.setTracer(&tracer);
+        Logger::addSink(sink);
+        // Let the sink's task start, it discards the messages until then.
+        vTaskDelay(pdMS_TO_TICKS(10));
+
+        startNs = Detail::nowNs();
+        std::vector<std::thread> producers;
+        for (unsigned producer = 0; producer < config.producers; producer++) {
+            producers.emplace_back([&config, producer] {
+                std::vector<char> payload(config.maxPayload + 32);
+                for (unsigned counter = 0; counter < config.messagesPerProducer; counter++) {
+                    Detail::makePayload(config, payload.data(), producer, counter);
+                    LOGI("STRESS", "%s", payload.data());
+                }
+            });
+        }
+        // The interrupt comes last, with the highest producer ID. It stops with the tasks, so as not to hold the run.
+        std::atomic<unsigned> producing = config.producers;
+        std::atomic<unsigned> isrLogged = 0;
+        std::thread           interrupt([&config, &producing, &isrLogged] {
+            std::vector<char> payload(config.maxPayload + 32);
+            for (unsigned counter = 0; counter < config.isrMessages && producing != 0; counter++) {
+                std::this_thread::sleep_for(config.isrPeriod);
+                Detail::makePayload(config, payload.data(), config.producers, counter);
+                Host::InterruptScope isr;
+                LOGI("STRESS", "%s", payload.data());
+                isrLogged++;
+            }
+        });
+        for (auto& producer : producers) {
+            producer.join();
+            producing--;
+        }
+        interrupt.join();
+        result.submitted = taskMessages + isrLogged;
+
+        const auto deadline = Detail::Clock::now() + config.timeout;
+        while (tracer.delivered() + tracer.dropped() < result.submitted && Detail::Clock::now() < deadline) {
+            vTaskDelay(1);
+        }
+        Logger::clearSinks();
+        // The sink's task is gone once it is destroyed, the tracer can be read.
+    }
+
+    tracer.fill(result, startNs);
+    return result;
+}
+}    // namespace Logging::Stress
+
+#endif    // VENDOR_LOGGING_TESTS_STRESS_HARNESS_H
@@ -0,0 +1,240 @@
+/**
+ * @file    test_binary.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Tests of the binary records, built with LOGGER_USE_BINARY_FORMAT.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#include "binary_format.h"
+#include "fakes.h"
+#include "logger.h"
+#include "mt_sink.h"
+#include "priority_ring.h"
+#include "proxy_sink.h"
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+static_assert(LOGGER_USE_BINARY_FORMAT);
+
+namespace Logging {
+namespace {
+//! Logger::s_binaryMaxLength, the size of the message frames.
+constexpr std::size_t s_frameMaxLength = 128;
+// type[1] level[1] timestamp[8] formatId[4]
+constexpr std::size_t s_tagOffset = 14;
+
+class BinaryTest : public ::testing::Test {
+protected:
+    Fakes::RecordingSink m_sink;
+
+    void SetUp() override { Logger::addSink(m_sink); }
+    void TearDown() override { Logger::clearSinks(); }
+
+    //! Payloads of the well-formed frames of a given type, the clock info record sent by addSink excepted.
+    [[nodiscard]] std::vector<std::string> payloads(Binary::RecordType type) const
+    {
+        std::vector<std::string> result;
+        for (const auto& record : m_sink.records()) {
+            const std::string& frame = record.text;
+            EXPECT_GE(frame.size(), Binary::s_frameOverhead + 1);
+            EXPECT_EQ(static_cast<std::uint8_t>(frame[0]), Binary::s_syncByte);
+
+            std::uint16_t length = 0;
+            std::memcpy(&length, &frame[1], sizeof(length));
+            EXPECT_EQ(frame.size(), length + Binary::s_frameOverhead);
+            std::uint8_t checksum = 0;
+            for (std::size_t i = 3; i < frame.size() - 1; i++) {
+                checksum ^= static_cast<std::uint8_t>(frame[i]);
+            }
+            EXPECT_EQ(checksum, static_cast<std::uint8_t>(frame.back()));
+
+            if (static_cast<Binary::RecordType>(frame[3]) == type) { result.push_back(frame.substr(3, length)); }
+        }
+        return result;
+    }
+
+    [[nodiscard]] std::uint32_t droppedTooLong() { return m_sink.stats().snapshot().droppedBy(DropCause::tooLong); }
+};
+
+}    // namespace
+
+TEST_F(BinaryTest, LongStringsAreTruncated)
+{
+    const std::string text(150, 'x');
+    LOGI("TAG", "%s", text.c_str());
+
+    const auto messages = payloads(Binary::RecordType::message);
+    ASSERT_EQ(messages.size(), 1U);
+    const std::string& payload = messages[0];
+    EXPECT_EQ(payload.size() + Binary::s_frameOverhead, s_frameMaxLength);
+    ASSERT_EQ(payload[s_tagOffset], 3);
+    const std::size_t argument = s_tagOffset + 1 + 3;
+    ASSERT_EQ(static_cast<Binary::ArgType>(payload[argument]), Binary::ArgType::string);
+    const auto length = static_cast<std::uint8_t>(payload[argument + 1]);
+    EXPECT_GT(length, 0U);
+    EXPECT_LT(length, text.size());
+    EXPECT_EQ(payload.size(), argument + 2 + length);
+    EXPECT_EQ(payload.substr(argument + 2), text.substr(0, length));
+    EXPECT_EQ(droppedTooLong(), 0U);
+}
+
+TEST_F(BinaryTest, ArgumentsAfterATruncatedStringAreKept)
+{
+    const std::string text(300, 'x');
+    LOGI("TAG", "%s %s %d", text.c_str(), "end", 42);
+
+    const auto messages = payloads(Binary::RecordType::message);
+    ASSERT_EQ(messages.size(), 1U);
+    const std::string& payload = messages[0];
+    std::int32_t       value   = 0;
+    std::memcpy(&value, &payload[payload.size() - sizeof(value)], sizeof(value));
+    EXPECT_EQ(value, 42);
+    EXPECT_EQ(droppedTooLong(), 0U);
+}
+
+TEST_F(BinaryTest, RecordsThatCantFitAreCountedAsDropped)
+{
+    LOGI("TAG",
+         "%d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d",
+         1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24);
+
+    EXPECT_TRUE(payloads(Binary::RecordType::message).empty());
+    EXPECT_EQ(droppedTooLong(), 1U);
+    EXPECT_EQ(m_sink.stats().snapshot().messages, 0U);
+}
+
+TEST_F(BinaryTest, LargeDumpsAreSplit)
+{
+    std::vector<std::uint8_t> data(1000);
+    for (std::size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<std::uint8_t>(i);
+    }
+    LOG_BUFFER_HEX("TAG", data.data(), data.size());
+
+    std::vector<std::uint8_t> received;
+    for (const auto& payload : payloads(Binary::RecordType::blob)) {
+        // type[1] level[1] timestamp[8] kind[1] addressSize[1] address[addressSize]
+        const std::size_t tag    = 12 + static_cast<std::uint8_t>(payload[11]);
+        const std::size_t offset = tag + 1 + static_cast<std::uint8_t>(payload[tag]);
+        std::uint16_t     length = 0;
+        std::memcpy(&length, &payload[offset], sizeof(length));
+        ASSERT_EQ(payload.size(), offset + sizeof(length) + length);
+        received.insert(received.end(), &payload[offset + sizeof(length)], &payload[offset + sizeof(length)] + length);
+    }
+    EXPECT_EQ(received, data);
+    EXPECT_EQ(droppedTooLong(), 0U);
+}
+
+TEST_F(BinaryTest, MtSinksReportTheirDropsInARecord)
+{
+    //! Slow enough for the interrupt below to fill the ring.
+    class SlowRecorder : public Fakes::RecordingSink {
+    public:
+        void onWrite(Level level, const char* string, std::size_t length) override
+        {
+            vTaskDelay(1);
+            RecordingSink::onWrite(level, string, length);
+        }
+    };
+
+    SlowRecorder recorder;
+    const auto   reported = [&recorder] {
+        std::uint32_t total = 0;
+        for (const auto& record : recorder.records()) {
+            const std::string& text = record.text;
+            EXPECT_EQ(static_cast<std::uint8_t>(text[0]), Binary::s_syncByte);
+            if (static_cast<Binary::RecordType>(text[3]) != Binary::RecordType::dropped) { continue; }
+            EXPECT_EQ(text.size(), Binary::s_droppedFrameSize);
+            EXPECT_EQ(record.level, Level::error);
+            std::uint32_t count = 0;
+            std::memcpy(&count, &text[3 + 1 + sizeof(std::uint64_t)], sizeof(count));
+            total += count;
+        }
+        return total;
+    };
+
+    std::uint32_t dropped = 0;
+    {
+        MtSink<ProxySink, 512> sink {&recorder};
+        // Let the sink's task start, it discards the messages until then.
+        vTaskDelay(pdMS_TO_TICKS(10));
+        Logger::addSink(sink);
+        {
+            // Interrupts don't wait for room.
+            Host::InterruptScope isr;
+            for (int i = 0; i < 50; i++) {
+                LOGI("TAG", "message %d", i);
+            }
+        }
+        dropped = sink.snapshotStats().droppedBy(DropCause::full);
+        for (int i = 0; i < 1000 && reported() != dropped; i++) {
+            vTaskDelay(1);
+        }
+        Logger::clearSinks();
+    }
+    EXPECT_NE(dropped, 0U);
+    EXPECT_EQ(reported(), dropped);
+}
+
+TEST_F(BinaryTest, PriorityQueuesNumberTheirMessages)
+{
+    Fakes::RecordingSink recorder;
+    {
+        MtSink<ProxySink, 1024, Priorities<Level::warning>::Ring> sink {&recorder};
+        // Let the sink's task start, it discards the messages until then.
+        vTaskDelay(pdMS_TO_TICKS(10));
+        // Queues the clock info record as well.
+        Logger::addSink(sink);
+        for (int i = 0; i < 3; i++) {
+            LOGT("TAG", "trace %d", i);
+        }
+        LOGE("TAG", "error %d", 3);
+        for (int i = 0; i < 1000 && recorder.size() != 5; i++) {
+            vTaskDelay(1);
+        }
+        Logger::clearSinks();
+    }
+
+    // Each message goes out after a sequence record, which gives the order they were logged in.
+    std::map<std::uint32_t, std::int32_t> values;
+    for (const auto& record : recorder.records()) {
+        const std::string& text = record.text;
+        ASSERT_GT(text.size(), Binary::s_sequenceFrameSize);
+        EXPECT_EQ(static_cast<std::uint8_t>(text[0]), Binary::s_syncByte);
+        ASSERT_EQ(static_cast<Binary::RecordType>(text[3]), Binary::RecordType::sequence);
+        std::uint32_t sequence = 0;
+        std::memcpy(&sequence, &text[4], sizeof(sequence));
+        EXPECT_EQ(static_cast<std::uint8_t>(text[Binary::s_sequenceFrameSize]), Binary::s_syncByte);
+        if (static_cast<Binary::RecordType>(text[Binary::s_sequenceFrameSize + 3]) != Binary::RecordType::message) {
+            continue;
+        }
+        std::int32_t value = 0;
+        std::memcpy(&value, &text[text.size() - 1 - sizeof(value)], sizeof(value));
+        values[sequence] = value;
+    }
+    ASSERT_EQ(values.size(), 4U);
+    std::int32_t expected = 0;
+    for (const auto& [sequence, value] : values) {
+        EXPECT_EQ(value, expected++) << "sequence " << sequence;
+    }
+}
+}    // namespace Logging
@@ -0,0 +1,78 @@
+/**
+ * @file    test_buffer_dump.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Tests of the text rendering of the buffer dumps.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#include "fakes.h"
+#include "logger.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Logging {
+namespace {
+class BufferDumpTest : public ::testing::Test {
+protected:
+    Fakes::RecordingSink m_sink;
+
+    void SetUp() override { Logger::addSink(m_sink); }
+    void TearDown() override { Logger::clearSinks(); }
+
+    //! Every line sent, without prefix nor line ending.
+    [[nodiscard]] std::vector<std::string> lines() const
+    {
+        std::vector<std::string> result;
+        for (const auto& record : m_sink.records()) {
+            std::size_t begin = 0;
+            while (begin < record.text.size()) {
+                const std::size_t tag = record.text.find("] ", begin) + 2;
+                const std::size_t end = record.text.find("\r\n", tag);
+                result.push_back(record.text.substr(tag, end - tag));
+                begin = end + 2;
+            }
+        }
+        return result;
+    }
+};
+}    // namespace
+
+TEST_F(BufferDumpTest, HexLinesHoldSixteenBytes)
+{
+    std::uint8_t data[20];
+    for (std::size_t i = 0; i < sizeof(data); i++) {
+        data[i] = static_cast<std::uint8_t>(i * 17);
+    }
+    LOG_BUFFER_HEX("TAG", data, sizeof(data));
+
+    const auto sent = lines();
+    ASSERT_EQ(sent.size(), 2U);
+    EXPECT_EQ(sent[0], "00 11 22 33 44 55 66 77 88 99 aa bb cc dd ee ff ");
+    EXPECT_EQ(sent[1], "10 21 32 43 ");
+}
+
+TEST_F(BufferDumpTest, CharLinesStopAtTheirFirstNullByte)
+{
+    const std::uint8_t data[] = "first line\0hiddenSECOND LINE";
+    LOG_BUFFER_CHAR("TAG", data, sizeof(data) - 1);
+
+    const auto sent = lines();
+    ASSERT_EQ(sent.size(), 2U);
+    EXPECT_EQ(sent[0], "first line");
+    EXPECT_EQ(sent[1], "nSECOND LINE");
+}
+}    // namespace Logging
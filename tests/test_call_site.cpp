@@ -0,0 +1,121 @@
+/**
+ * @file    test_call_site.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Tests of the logger cache of the log call sites.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#include "fakes.h"
+#include "logger.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace Logging {
+namespace {
+class CallSiteTest : public ::testing::Test {
+protected:
+    Fakes::RecordingSink m_sink;
+
+    void SetUp() override { Logger::addSink(m_sink); }
+    void TearDown() override
+    {
+        Logger::clearSinks();
+        Logger::clearLevel();
+        Logger::clearLevel("OTHER");
+    }
+};
+
+//! A call site shared by every tag, like a helper taking the tag as a parameter.
+void logDebug(std::string_view tag, int value)
+{
+    LOGD(tag, "value %d", value);
+}
+
+std::uint32_t filteredCalls()
+{
+    return Logger::snapshotStats()[0].stats.filtered;
+}
+}    // namespace
+
+TEST_F(CallSiteTest, FollowsTheLevelChanges)
+{
+    Logger::setLevel(Level::info);
+    const std::uint32_t filtered = filteredCalls();
+    for (int i = 0; i < 3; i++) {
+        logDebug("TAG", i);
+    }
+    EXPECT_EQ(m_sink.size(), 0U);
+    EXPECT_EQ(filteredCalls(), filtered + 3);
+
+    Logger::setLevel(Level::debug);
+    logDebug("TAG", 3);
+    ASSERT_EQ(m_sink.size(), 1U);
+    EXPECT_TRUE(m_sink.records()[0].text.ends_with("[TAG] value 3\r\n"));
+
+    Logger::setLevel(Level::info);
+    logDebug("TAG", 4);
+    EXPECT_EQ(m_sink.size(), 1U);
+}
+
+TEST_F(CallSiteTest, SharedCallSitesLookTheOtherTagsUp)
+{
+    Logger::setLevel(Level::info);
+    Logger::setLevel("OTHER", Level::debug);
+
+    logDebug("TAG", 1);
+    logDebug("OTHER", 2);
+    logDebug("TAG", 3);
+    logDebug("OTHER", 4);
+
+    const auto records = m_sink.records();
+    ASSERT_EQ(records.size(), 2U);
+    EXPECT_TRUE(records[0].text.ends_with("[OTHER] value 2\r\n"));
+    EXPECT_TRUE(records[1].text.ends_with("[OTHER] value 4\r\n"));
+}
+
+TEST_F(CallSiteTest, SurvivesConcurrentRefreshes)
+{
+    static constexpr int s_calls = 20000;
+
+    Logger::setLevel(Level::info);
+    std::atomic<bool>        stop = false;
+    std::vector<std::thread> threads;
+    for (std::string_view tag : {"TAG", "OTHER"}) {
+        threads.emplace_back([tag] {
+            for (int i = 0; i < s_calls; i++) {
+                logDebug(tag, i);
+            }
+        });
+    }
+    std::thread configurator([&stop] {
+        while (!stop) {
+            Logger::setLevel("OTHER", Level::debug);
+            Logger::clearLevel("OTHER");
+        }
+    });
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    stop = true;
+    configurator.join();
+
+    for (const auto& record : m_sink.records()) {
+        EXPECT_NE(record.text.find("[OTHER]"), std::string::npos) << record.text;
+    }
+}
+}    // namespace Logging
@@ -0,0 +1,53 @@
+/**
+ * @file    test_compile_level.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Tests of LOGGER_COMPILE_LEVEL, built with it set to info.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#include "fakes.h"
+#include "logger.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+namespace Logging {
+static_assert(!isLevelCompiledIn(Level::debug) && isLevelCompiledIn(Level::info),
+              "This test must be built with LOGGER_COMPILE_LEVEL set to info");
+
+TEST(CompileLevel, RemovesTheCallsAboveIt)
+{
+    Fakes::RecordingSink sink;
+    Logger::addSink(sink);
+    Logger::setLevel(Level::all);
+
+    const std::uint8_t buffer[] = {1, 2, 3, 4};
+    LOGT("TAG", "trace %d", 1);
+    LOGD("TAG", "debug %d", 2);
+    LOGD_F("TAG", "debug {}", 3);
+    LOG_BUFFER_HEX_LEVEL("TAG", Level::debug, buffer, sizeof(buffer));
+    LOGI("TAG", "info %d", 4);
+    LOGI_F("TAG", "info {}", 5);
+    LOG_BUFFER_HEX("TAG", buffer, sizeof(buffer));
+
+    Logger::clearSinks();
+    Logger::clearLevel();
+
+    const auto records = sink.records();
+    ASSERT_EQ(records.size(), 3U);
+    EXPECT_TRUE(records[0].text.ends_with("[TAG] info 4\r\n"));
+    EXPECT_TRUE(records[1].text.ends_with("[TAG] info 5\r\n"));
+    EXPECT_NE(records[2].text.find("01 02 03 04"), std::string::npos) << records[2].text;
+}
+}    // namespace Logging
@@ -0,0 +1,156 @@
+/**
+ * @file    test_host_port.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Tests of the FreeRTOS stand-in the host build runs on.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#include "fakes.h"
+#include "logger.h"
+#include "mt_sink.h"
+#include "port.h"
+#include "proxy_sink.h"
+
+#include <FreeRTOS.h>
+#include <semphr.h>
+#include <task.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+namespace Logging {
+namespace {
+struct Blocker {
+    std::atomic<bool> started  = false;
+    std::atomic<bool> unwound  = false;
+    std::atomic<int>  notified = 0;
+};
+
+void waitForever(void* args)
+{
+    auto& blocker   = *static_cast<Blocker*>(args);
+    blocker.started = true;
+    struct Unwinder {
+        Blocker& blocker;
+        ~Unwinder() { blocker.unwound = true; }
+    } unwinder {blocker};
+    while (true) {
+        blocker.notified += static_cast<int>(ulTaskNotifyTake(pdTRUE, portMAX_DELAY));
+    }
+}
+
+void deleteSelf(void* args)
+{
+    static_cast<Blocker*>(args)->started = true;
+    vTaskDelete(nullptr);
+}
+}    // namespace
+
+TEST(HostPort, NotifiesAndDeletesTasks)
+{
+    Blocker      blocker;
+    TaskHandle_t task = nullptr;
+    ASSERT_EQ(xTaskCreate(&waitForever, "test", configMINIMAL_STACK_SIZE, &blocker, 1, &task), pdPASS);
+    while (!blocker.started) { vTaskDelay(1); }
+
+    xTaskNotifyGive(task);
+    while (blocker.notified == 0) { vTaskDelay(1); }
+
+    vTaskDelete(task);
+    EXPECT_TRUE(blocker.unwound);
+}
+
+TEST(HostPort, StaticTasksUseTheirBuffer)
+{
+    Blocker      blocker;
+    StaticTask_t buffer {};
+    TaskHandle_t task = xTaskCreateStatic(&waitForever, "test", configMINIMAL_STACK_SIZE, &blocker, 1, nullptr, &buffer);
+    ASSERT_EQ(static_cast<void*>(task), static_cast<void*>(&buffer));
+    while (!blocker.started) { vTaskDelay(1); }
+    vTaskDelete(task);
+    EXPECT_TRUE(blocker.unwound);
+}
+
+TEST(HostPort, TasksCanDeleteThemselves)
+{
+    Blocker      blocker;
+    TaskHandle_t task = nullptr;
+    ASSERT_EQ(xTaskCreate(&deleteSelf, "test", configMINIMAL_STACK_SIZE, &blocker, 1, &task), pdPASS);
+    while (!blocker.started) { vTaskDelay(1); }
+}
+
+TEST(HostPort, NotificationsCount)
+{
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    xTaskNotifyGive(self);
+    xTaskNotifyGive(self);
+    EXPECT_EQ(ulTaskNotifyTake(pdFALSE, 0), 2U);
+    EXPECT_EQ(ulTaskNotifyTake(pdTRUE, 0), 1U);
+    EXPECT_EQ(ulTaskNotifyTake(pdTRUE, 1), 0U);
+}
+
+TEST(HostPort, SemaphoresTimeOut)
+{
+    StaticSemaphore_t buffer {};
+    SemaphoreHandle_t binary = xSemaphoreCreateBinaryStatic(&buffer);
+    EXPECT_EQ(xSemaphoreTake(binary, 1), pdFAIL);
+    EXPECT_EQ(xSemaphoreGive(binary), pdPASS);
+    EXPECT_EQ(xSemaphoreTake(binary, 1), pdPASS);
+    vSemaphoreDelete(binary);
+
+    SemaphoreHandle_t mutex = xSemaphoreCreateMutex();
+    EXPECT_EQ(xSemaphoreTake(mutex, 0), pdPASS);
+    EXPECT_EQ(xSemaphoreTake(mutex, 0), pdFAIL);
+    EXPECT_EQ(xSemaphoreGive(mutex), pdPASS);
+    vSemaphoreDelete(mutex);
+}
+
+TEST(HostPort, InterruptScopeSimulatesAnInterrupt)
+{
+    EXPECT_FALSE(Port::isInIsr());
+    {
+        Host::InterruptScope isr;
+        EXPECT_TRUE(Port::isInIsr());
+    }
+    EXPECT_FALSE(Port::isInIsr());
+}
+
+TEST(HostPort, MtSinkDeliversInOrder)
+{
+    static constexpr int s_count = 2000;
+
+    Fakes::RecordingSink recorder;
+    {
+        MtSink<ProxySink> sink {&recorder};
+        Logger::addSink(sink);
+        // Let the sink's task start, it discards the messages until then.
+        vTaskDelay(pdMS_TO_TICKS(10));
+        for (int i = 0; i < s_count; i++) {
+            LOGI("HOST", "message %d", i);
+        }
+        // The sink drops what's still queued when destroyed.
+        for (int i = 0; i < 1000 && recorder.size() != s_count; i++) {
+            vTaskDelay(1);
+        }
+        Logger::clearSinks();
+    }
+
+    const auto records = recorder.records();
+    ASSERT_EQ(records.size(), static_cast<std::size_t>(s_count));
+    for (int i = 0; i < s_count; i++) {
+        EXPECT_TRUE(records[i].text.ends_with("] message " + std::to_string(i) + "\r\n")) << records[i].text;
+    }
+}
+}    // namespace Logging
@@ -0,0 +1,77 @@
+/**
+ * @file    test_mini_printf.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Tests of the printf subset against the libc one.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#include "mini_printf.h"
+
+#include <gtest/gtest.h>
+
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+
+namespace Logging {
+namespace {
+//! Formats with both printfs, expecting the same output and length.
+#define EXPECT_SAME_AS_LIBC(fmt, ...)                                                                                  \
+    do {                                                                                                               \
+        char              expected[128];                                                                               \
+        char              actual[128];                                                                                 \
+        const int         expectedLength = std::snprintf(expected, sizeof(expected), fmt __VA_OPT__(, ) __VA_ARGS__);  \
+        const std::size_t actualLength   = Printf::format(actual, sizeof(actual), fmt __VA_OPT__(, ) __VA_ARGS__);     \
+        EXPECT_STREQ(actual, expected) << "format: " << (fmt);                                                         \
+        EXPECT_EQ(actualLength, static_cast<std::size_t>(expectedLength)) << "format: " << (fmt);                     \
+    } while (0)
+}    // namespace
+
+TEST(MiniPrintfTest, IntegersMatchTheLibc)
+{
+    EXPECT_SAME_AS_LIBC("%d %i %u", -42, 17, 3000000000U);
+    EXPECT_SAME_AS_LIBC("[%5d] [%-5d] [%05d] [%+d] [% d]", 42, 42, -42, 42, 42);
+    EXPECT_SAME_AS_LIBC("[%.3d] [%8.3d] [%-8.3x] [%.0d] [%5.0d]", 7, -7, 255, 0, 0);
+    EXPECT_SAME_AS_LIBC("%x %X %#x %#X %#x", 0xbeefU, 0xbeefU, 0xbeefU, 0xbeefU, 0U);
+    EXPECT_SAME_AS_LIBC("%o %#o %#o %#.0o %#.3o %#5.0o", 8U, 8U, 0U, 0U, 8U, 0U);
+    EXPECT_SAME_AS_LIBC("%hhd %hd %ld %lld %zu %jd", 300, 70000, -5L, LLONG_MIN, sizeof(int), INTMAX_MAX);
+    EXPECT_SAME_AS_LIBC("%*d|%-*d|%.*d", 6, 1, 6, 2, 4, 3);
+}
+
+TEST(MiniPrintfTest, StringsAndCharactersMatchTheLibc)
+{
+    EXPECT_SAME_AS_LIBC("[%s] [%10s] [%-10s] [%.3s] [%c] [%3c]", "text", "text", "text", "text", 'a', 'b');
+    int value = 0;
+    EXPECT_SAME_AS_LIBC("100%% %p", static_cast<void*>(&value));
+}
+
+TEST(MiniPrintfTest, FloatsMatchTheLibc)
+{
+    EXPECT_SAME_AS_LIBC("%f %f %f %f", 0.0, 1.5, -2.25, 123456.789);
+    EXPECT_SAME_AS_LIBC("%.0f %.0f %.0f %.0f %.0f", 0.5, 1.5, 2.5, 3.5, -0.5);
+    EXPECT_SAME_AS_LIBC("%.1f %.2f %.2f %.3f", 0.25, 0.125, 0.375, 9.9995);
+    EXPECT_SAME_AS_LIBC("%.2f %.0f %#.0f %+.1f %08.2f %-8.2f|", 9.999, 0.4, 3.0, 1.25, -3.14159, 2.5);
+    EXPECT_SAME_AS_LIBC("%e %E %.2e %.0e", 12345.678, 0.00012, 9.999, 2.5);
+    EXPECT_SAME_AS_LIBC("%f %F %5f", std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+                        std::numeric_limits<double>::quiet_NaN());
+}
+
+TEST(MiniPrintfTest, OutputIsTruncatedToTheBuffer)
+{
+    char              buffer[8];
+    const std::size_t length = Printf::format(buffer, sizeof(buffer), "%s %d", "truncated", 12345);
+    EXPECT_EQ(length, 15U);
+    EXPECT_STREQ(buffer, "truncat");
+}
+}    // namespace Logging
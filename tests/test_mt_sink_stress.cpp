@@ -0,0 +1,73 @@
+/**
+ * @file    test_mt_sink_stress.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Short runs of the stress harness, checking that MtSink loses, reorders and corrupts nothing under load.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "mt_sink.h"
+#include "proxy_sink.h"
+#include "stress_harness.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+
+namespace Logging {
+namespace {
+template<std::size_t MaxLength, OverflowStrategy Strategy = OverflowStrategy::block>
+struct StressPolicy : MtSinkPolicy {
+    static constexpr OverflowStrategy overflow         = Strategy;
+    static constexpr std::size_t      messageMaxLength = MaxLength;
+};
+
+Stress::Config shortRun()
+{
+    Stress::Config config;
+    config.producers           = 3;
+    config.messagesPerProducer = 500;
+    config.isrMessages         = 100;
+    return config;
+}
+
+void expectIntact(const Stress::Result& result)
+{
+    EXPECT_EQ(result.lost, 0);
+    EXPECT_EQ(result.outOfOrder, 0);
+    EXPECT_EQ(result.corrupted, 0);
+    EXPECT_EQ(result.delivered + result.dropped, result.submitted);
+    EXPECT_NE(result.delivered, 0);
+}
+}    // namespace
+
+TEST(MtSinkStress, BlockingProducersOnlyDropFromInterrupts)
+{
+    const auto result = Stress::run<MtSink<ProxySink>>(shortRun());
+    expectIntact(result);
+    EXPECT_EQ(result.dropped, result.droppedIsr);
+}
+
+TEST(MtSinkStress, SmallRingsDropMessagesButLoseNone)
+{
+    const auto result = Stress::run<MtSink<ProxySink, 512, MpscRing, StressPolicy<96>>>(shortRun());
+    expectIntact(result);
+    // The longest payloads don't fit.
+    EXPECT_GT(result.dropped, result.droppedIsr);
+}
+
+TEST(MtSinkStress, DiscardedMessagesAreAccountedFor)
+{
+    const auto result =
+      Stress::run<MtSink<ProxySink, 1024, MpscRing, StressPolicy<SIZE_MAX, OverflowStrategy::dropOldest>>>(shortRun());
+    expectIntact(result);
+}
+}    // namespace Logging
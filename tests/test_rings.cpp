@@ -0,0 +1,114 @@
+/**
+ * @file    test_rings.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Tests of the rings the MtSinks queue their messages in.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#include "laned_ring.h"
+#include "mpsc_ring.h"
+
+#include <FreeRTOS.h>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+
+namespace Logging {
+TEST(MpscRing, CommitOnlyShrinksTheLastReservation)
+{
+    using Ring = MpscRing<128>;
+    Ring ring;
+
+    // A later reservation exists, the first record keeps all its room.
+    char* first  = ring.reserve(40);
+    char* second = ring.reserve(8);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    std::memcpy(first, "abcd", 5);
+    ring.commit(first, 4);
+    std::memcpy(second, "efghijkl", 8);
+    ring.commit(second);
+    EXPECT_EQ(ring.used(), 64);
+
+    Ring::Record record;
+    ASSERT_TRUE(ring.read(record));
+    EXPECT_EQ(std::string(record.data, record.length), "abcd");
+    ASSERT_TRUE(ring.read(record));
+    EXPECT_EQ(std::string(record.data, record.length), "efghijkl");
+    EXPECT_FALSE(ring.read(record));
+    ring.release();
+    EXPECT_EQ(ring.used(), 0);
+
+    // The last reservation gives its room back.
+    char* shrunk = ring.reserve(40);
+    ASSERT_NE(shrunk, nullptr);
+    std::memcpy(shrunk, "mnop", 5);
+    ring.commit(shrunk, 4);
+    EXPECT_EQ(ring.used(), 16);
+
+    // Doesn't fit before the end of the ring, the rest of it is skipped with padding.
+    char* wrapped = ring.reserve(48);
+    ASSERT_NE(wrapped, nullptr);
+    EXPECT_EQ(ring.used(), 120);
+    std::memset(wrapped, 'w', 48);
+    ring.commit(wrapped);
+
+    ASSERT_TRUE(ring.read(record));
+    EXPECT_EQ(std::string(record.data, record.length), "mnop");
+    ASSERT_TRUE(ring.read(record));
+    EXPECT_EQ(std::string(record.data, record.length), std::string(48, 'w'));
+    EXPECT_FALSE(ring.read(record));
+    ring.release();
+    EXPECT_EQ(ring.used(), 0);
+}
+
+TEST(LanedRing, InterruptsOfARegisteredPriorityHaveALaneOfTheirOwn)
+{
+    using Ring = LanedRing<64, 1, 1>;
+    Ring ring;
+    EXPECT_TRUE(ring.registerInterruptPriority(5));
+    EXPECT_TRUE(ring.registerInterruptPriority(5));
+    EXPECT_FALSE(ring.registerInterruptPriority(6));
+
+    // Fill the shared lane from a task.
+    char* fromTask = ring.reserve(Ring::s_maxLength);
+    ASSERT_NE(fromTask, nullptr);
+    {
+        Host::InterruptScope isr(16 + 1, 6);
+        EXPECT_EQ(ring.reserve(4), nullptr);
+    }
+
+    char* fromIsr = nullptr;
+    {
+        Host::InterruptScope isr(16 + 2, 5);
+        fromIsr = ring.reserve(4);
+        ASSERT_NE(fromIsr, nullptr);
+        std::memcpy(fromIsr, "isr", 4);
+        ring.commit(fromIsr);
+    }
+    std::memcpy(fromTask, "task", 5);
+    ring.commit(fromTask, 5);
+
+    // Merged in the order they were reserved.
+    Ring::Record record;
+    ASSERT_TRUE(ring.read(record));
+    EXPECT_EQ(std::string(record.data, record.length), std::string("task", 5));
+    ASSERT_TRUE(ring.read(record));
+    EXPECT_EQ(std::string(record.data, record.length), std::string("isr", 4));
+    EXPECT_FALSE(ring.read(record));
+    ring.release();
+    EXPECT_EQ(ring.used(), 0);
+}
+}    // namespace Logging
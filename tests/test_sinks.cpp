@@ -0,0 +1,401 @@
+/**
+ * @file    test_sinks.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Tests of the sinks, with fake transports.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#include "colors.h"
+#include "dma_uart_sink.h"
+#include "fakes.h"
+#include "file_sink.h"
+#include "logger.h"
+#include "retained_ram_sink.h"
+#include "uart_sink.h"
+#include "usb_sink.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Logging {
+namespace {
+class SinkTest : public ::testing::Test {
+protected:
+    void TearDown() override { Logger::clearSinks(); }
+};
+
+//! What the sinks adding colors send for a message.
+std::string colored(Level level, const std::string& text)
+{
+    std::string result(colorStrFromLevel(level));
+    result += text;
+    if (!colorStrFromLevel(level).empty()) { result += s_resetColor; }
+    return result;
+}
+
+std::string joined(const std::vector<std::string>& parts)
+{
+    std::string result;
+    for (const auto& part : parts) {
+        result += part;
+    }
+    return result;
+}
+}    // namespace
+
+TEST_F(SinkTest, LevelCanChangeWhileLogging)
+{
+    Fakes::CountingSink sink;
+    Logger::addSink(sink);
+
+    std::atomic<bool> done = false;
+    std::thread       toggler([&] {
+        for (int i = 0; i < 1000; i++) {
+            sink.setLevel(i % 2 == 0 ? Level::error : Level::all);
+        }
+        sink.setLevel(Level::info);
+        done = true;
+    });
+    while (!done) {
+        LOGI("TAG", "message");
+    }
+    toggler.join();
+
+    const std::size_t before = sink.messages;
+    LOGD("TAG", "filtered by the sink");
+    LOGI("TAG", "delivered");
+    EXPECT_EQ(sink.messages, before + 1);
+    EXPECT_EQ(sink.getLevel(), Level::info);
+}
+
+TEST_F(SinkTest, MessagesAreOnlyFormattedInPlaceForASingleSink)
+{
+    Fakes::LendingSink   lending;
+    Fakes::RecordingSink other;
+    other.setLevel(Level::error);
+    Logger::addSink(lending);
+    Logger::addSink(other);
+
+    LOGI("TAG", "only for the lending sink");
+    EXPECT_EQ(lending.reservations, 1);
+    ASSERT_EQ(lending.messages.size(), 1);
+    EXPECT_NE(lending.messages[0].find("only for the lending sink"), std::string::npos);
+
+    // The lending sink's reservation mustn't stay open while the other sink writes.
+    LOGE("TAG", "for both");
+    EXPECT_EQ(lending.reservations, 1);
+    ASSERT_EQ(lending.messages.size(), 2);
+    ASSERT_EQ(other.size(), 1);
+    EXPECT_EQ(other.records()[0].text, lending.messages[1]);
+}
+
+TEST_F(SinkTest, UartSinkPacksBatchesInTransfersOfAtMost256Bytes)
+{
+    UART_HandleTypeDef huart;
+    UartSink           sink(&huart);
+
+    const std::string   text(100, 'x');
+    const Sink::Message messages[] = {{Level::info, text.data(), text.size()},
+                                      {Level::info, text.data(), text.size()},
+                                      {Level::info, text.data(), text.size()}};
+    sink.onWriteBatch(&messages[0], std::size(messages));
+
+    // The third message doesn't fit after the first two, the batch is sent before it.
+    const auto transfers = huart.tx.transfers();
+    ASSERT_EQ(transfers.size(), 2);
+    EXPECT_EQ(transfers[0].length, 2 * colored(Level::info, text).size() + colorStrFromLevel(Level::info).size());
+    EXPECT_EQ(huart.tx.bytes(), colored(Level::info, text) + colored(Level::info, text) + colored(Level::info, text));
+}
+
+TEST_F(SinkTest, UartSinkSendsWhatDoesntFitTheBatchAsIs)
+{
+    UART_HandleTypeDef huart;
+    UartSink           sink(&huart);
+
+    const std::string   text(300, 'x');
+    const Sink::Message message = {Level::info, text.data(), text.size()};
+    sink.onWriteBatch(&message, 1);
+
+    const auto transfers = huart.tx.transfers();
+    ASSERT_EQ(transfers.size(), 3);
+    EXPECT_EQ(transfers[1].length, text.size());
+    EXPECT_EQ(huart.tx.bytes(), colored(Level::info, text));
+}
+
+TEST_F(SinkTest, UsbSinkQueuesFullPacketsAndKeepsThePartialOneUntilFlushed)
+{
+    Fakes::FakeCdcTransport transport;
+    UsbSink                 sink(transport, UsbSink::s_fullSpeedPacketSize);
+
+    const std::string   text(40, 'x');
+    const Sink::Message messages[] = {{Level::info, text.data(), text.size()},
+                                      {Level::info, text.data(), text.size()},
+                                      {Level::info, text.data(), text.size()}};
+    sink.onWriteBatch(&messages[0], std::size(messages));
+
+    const std::string expected = colored(Level::info, text) + colored(Level::info, text) + colored(Level::info, text);
+    ASSERT_EQ(transport.queueCalls.size(), expected.size() / UsbSink::s_fullSpeedPacketSize);
+    for (const auto& packet : transport.queueCalls) {
+        EXPECT_EQ(packet.size(), UsbSink::s_fullSpeedPacketSize);
+    }
+
+    sink.flush();
+    ASSERT_EQ(transport.queueCalls.size(), expected.size() / UsbSink::s_fullSpeedPacketSize + 1);
+    EXPECT_EQ(transport.queueCalls.back().size(), expected.size() % UsbSink::s_fullSpeedPacketSize);
+    EXPECT_EQ(joined(transport.packets), expected);
+}
+
+TEST_F(SinkTest, UsbSinkSendsSingleMessagesRightAway)
+{
+    Fakes::FakeCdcTransport transport;
+    UsbSink                 sink(transport);
+
+    sink.onWrite(Level::warning, "short", 5);
+
+    EXPECT_EQ(joined(transport.packets), colored(Level::warning, "short"));
+}
+
+TEST_F(SinkTest, UsbSinkCountsTheMessagesOfDroppedPacketsOnce)
+{
+    Fakes::FakeCdcTransport transport;
+    transport.capacity    = 2 * UsbSink::s_fullSpeedPacketSize;
+    transport.hostReading = false;
+    UsbSink sink(transport);
+
+    // Fills the queue, then spans three packets that can't be queued.
+    const std::string first(2 * UsbSink::s_fullSpeedPacketSize - colored(Level::info, "").size(), 'a');
+    const std::string second(150, 'b');
+    sink.onWrite(Level::info, first.data(), first.size());
+    sink.onWrite(Level::info, second.data(), second.size());
+    EXPECT_EQ(sink.snapshotStats().droppedBy(DropCause::transport), 1);
+
+    transport.hostReading = true;
+    sink.onWrite(Level::info, "third", 5);
+
+    const std::string sent = joined(transport.packets);
+    EXPECT_EQ(sent,
+              colored(Level::info, first) + colored(Level::error, "Dropped 1 messages!\r\n") +
+                colored(Level::info, "third"));
+    EXPECT_EQ(sink.snapshotStats().droppedBy(DropCause::transport), 1);
+}
+
+TEST_F(SinkTest, FileSinkOnlyWritesWholeSectorsUntilFlushed)
+{
+    Fakes::FakeFileBackend backend;
+    char                   buffer[32];
+    FileSink               sink(backend, {.path = "log.txt", .buffer = buffer, .sectorSize = 16});
+
+    const std::string first(20, 'a');
+    const std::string second(20, 'b');
+    const std::string third(10, 'c');
+    sink.onWrite(Level::info, first.data(), first.size());
+    EXPECT_TRUE(backend.writes.empty());
+    sink.onWrite(Level::info, second.data(), second.size());
+    ASSERT_EQ(backend.writes.size(), 1);
+    EXPECT_EQ(backend.writes[0].length, sizeof(buffer));
+
+    // The partial sector is written, then rewritten whole along with what follows.
+    sink.flush();
+    sink.onWrite(Level::info, third.data(), third.size());
+    sink.flush();
+
+    for (const auto& write : backend.writes) {
+        EXPECT_EQ(write.offset % 16, 0) << "at " << write.offset;
+    }
+    EXPECT_EQ(backend.files["log.txt"], first + second + third);
+    EXPECT_EQ(backend.syncs, 2);
+}
+
+TEST_F(SinkTest, FileSinkRotatesFullFilesAndKeepsMaxFiles)
+{
+    Fakes::FakeFileBackend backend;
+    backend.files["log.txt"] = "previous run";
+    char     buffer[32];
+    FileSink sink(backend, {.path = "log.txt", .buffer = buffer, .sectorSize = 16, .maxFileSize = 32, .maxFiles = 3});
+    EXPECT_EQ(backend.files["log.txt.1"], "previous run");
+
+    for (char c : {'a', 'b', 'c'}) {
+        const std::string data(32, c);
+        sink.onWrite(Level::info, data.data(), data.size());
+    }
+    sink.onWrite(Level::info, "d", 1);
+    sink.flush();
+
+    EXPECT_EQ(backend.files.size(), 3);
+    EXPECT_EQ(backend.files["log.txt"], "d");
+    EXPECT_EQ(backend.files["log.txt.1"], std::string(32, 'c'));
+    EXPECT_EQ(backend.files["log.txt.2"], std::string(32, 'b'));
+}
+
+TEST_F(SinkTest, FileSinkCountsTheSectorsItFailedToWrite)
+{
+    Fakes::FakeFileBackend backend;
+    char                   buffer[32];
+    FileSink               sink(backend, {.path = "log.txt", .buffer = buffer, .sectorSize = 16});
+
+    backend.failWrites = true;
+    const std::string lost(32, 'a');
+    sink.onWrite(Level::info, lost.data(), lost.size());
+    EXPECT_EQ(sink.writeErrors(), 1);
+    EXPECT_EQ(sink.snapshotStats().droppedBy(DropCause::transport), 1);
+
+    backend.failWrites = false;
+    sink.onWrite(Level::info, "kept", 4);
+    sink.flush();
+    EXPECT_EQ(backend.files["log.txt"], "kept");
+}
+
+namespace {
+//! A region of 4 slots of 32 bytes, a plain buffer standing in for the retained RAM.
+struct RetainedRegion {
+    static constexpr std::size_t s_slotSize = 32;
+
+    alignas(4) char bytes[16 + 4 * s_slotSize] = {};
+
+    std::vector<std::string> replay(const RetainedRamSink& sink) const
+    {
+        Fakes::RecordingSink recorder;
+        sink.replay(recorder);
+        std::vector<std::string> texts;
+        for (const auto& record : recorder.records()) {
+            texts.push_back(record.text);
+        }
+        return texts;
+    }
+};
+}    // namespace
+
+TEST_F(SinkTest, RetainedRamSinkReplaysTheLastMessagesOldestFirst)
+{
+    RetainedRegion  region;
+    RetainedRamSink sink(&region.bytes[0], sizeof(region.bytes), RetainedRegion::s_slotSize);
+
+    for (const char* text : {"one", "two", "three", "four", "five", "six"}) {
+        sink.onWrite(Level::info, text, std::strlen(text));
+    }
+
+    EXPECT_EQ(region.replay(sink), (std::vector<std::string> {"three", "four", "five", "six"}));
+}
+
+TEST_F(SinkTest, RetainedRamSinkKeepsTheRecordsOfTheSameGeometryAcrossResets)
+{
+    RetainedRegion region;
+    {
+        RetainedRamSink sink(&region.bytes[0], sizeof(region.bytes), RetainedRegion::s_slotSize);
+        sink.onWrite(Level::error, "before the reset", 16);
+    }
+
+    RetainedRamSink afterReset(&region.bytes[0], sizeof(region.bytes), RetainedRegion::s_slotSize);
+    EXPECT_EQ(region.replay(afterReset), (std::vector<std::string> {"before the reset"}));
+
+    RetainedRamSink otherGeometry(&region.bytes[0], sizeof(region.bytes), 2 * RetainedRegion::s_slotSize);
+    EXPECT_TRUE(region.replay(otherGeometry).empty());
+}
+
+TEST_F(SinkTest, RetainedRamSinkSkipsTornRecords)
+{
+    RetainedRegion  region;
+    RetainedRamSink sink(&region.bytes[0], sizeof(region.bytes), RetainedRegion::s_slotSize);
+
+    sink.onWrite(Level::info, "intact", 6);
+    sink.onWrite(Level::info, "torn", 4);
+
+    // As if the reset happened in the middle of the copy.
+    char* torn = std::search(std::begin(region.bytes), std::end(region.bytes), "torn", &"torn"[4]);
+    ASSERT_NE(torn, std::end(region.bytes));
+    torn[2] = 'X';
+
+    EXPECT_EQ(region.replay(sink), (std::vector<std::string> {"intact"}));
+}
+
+TEST_F(SinkTest, RetainedRamSinkSplitsTheMessagesLongerThanASlot)
+{
+    RetainedRegion  region;
+    RetainedRamSink sink(&region.bytes[0], sizeof(region.bytes), RetainedRegion::s_slotSize);
+
+    // 20 bytes of data per slot.
+    const std::string longText = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJ";
+    sink.onWrite(Level::error, "short", 5);
+    sink.onWrite(Level::error, longText.data(), longText.size());
+    EXPECT_EQ(region.replay(sink), (std::vector<std::string> {"short", longText}));
+
+    // Its first part is overwritten, the rest mustn't be replayed on its own.
+    sink.onWrite(Level::error, "newer", 5);
+    sink.onWrite(Level::error, "newest", 6);
+    EXPECT_EQ(region.replay(sink), (std::vector<std::string> {"newer", "newest"}));
+
+    // A message that would take every slot is dropped.
+    const std::string tooLong(4 * 20 + 1, 'x');
+    sink.onWrite(Level::error, tooLong.data(), tooLong.size());
+    EXPECT_EQ(region.replay(sink), (std::vector<std::string> {"newer", "newest"}));
+    EXPECT_EQ(sink.snapshotStats().droppedBy(DropCause::tooLong), 1);
+}
+
+TEST_F(SinkTest, DmaUartSinkFillsOneBufferWhileTheOtherIsSent)
+{
+    Fakes::FakeUartTransport transport;
+    DmaUartSink              sink(transport);
+
+    sink.onWrite(Level::info, "first", 5);
+    sink.onWrite(Level::info, "second", 6);
+    sink.onWrite(Level::warning, "third", 5);
+    ASSERT_EQ(transport.transfers.size(), 1);
+    EXPECT_EQ(transport.transfers[0], colored(Level::info, "first"));
+
+    // The completion interrupt chains what was written in the meantime.
+    transport.complete();
+    ASSERT_EQ(transport.transfers.size(), 2);
+    EXPECT_EQ(transport.transfers[1], colored(Level::info, "second") + colored(Level::warning, "third"));
+
+    transport.complete();
+    EXPECT_EQ(transport.transfers.size(), 2);
+}
+
+TEST_F(SinkTest, DmaUartSinkSendsEachBufferOnceWhenTheTransferCompletesRightAway)
+{
+    Fakes::FakeUartTransport transport;
+    transport.completeInStart = true;
+    DmaUartSink sink(transport);
+
+    sink.onWrite(Level::info, "first", 5);
+    sink.onWrite(Level::info, "second", 6);
+    sink.onWrite(Level::info, "third", 5);
+
+    EXPECT_EQ(transport.transfers,
+              (std::vector<std::string> {
+                colored(Level::info, "first"), colored(Level::info, "second"), colored(Level::info, "third")}));
+}
+
+TEST_F(SinkTest, DmaUartSinkCountsTheTransfersThatCouldntStart)
+{
+    Fakes::FakeUartTransport transport;
+    DmaUartSink              sink(transport);
+
+    transport.fail = true;
+    sink.onWrite(Level::info, "lost", 4);
+    EXPECT_EQ(sink.droppedTransfers(), 1);
+    EXPECT_EQ(sink.snapshotStats().droppedBy(DropCause::transport), 1);
+
+    transport.fail = false;
+    sink.onWrite(Level::info, "sent", 4);
+    ASSERT_EQ(transport.transfers.size(), 1);
+    EXPECT_EQ(transport.transfers[0], colored(Level::info, "sent"));
+    transport.complete();
+}
+}    // namespace Logging
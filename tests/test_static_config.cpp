@@ -0,0 +1,119 @@
+/**
+ * @file    test_static_config.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Checks that nothing is allocated with LOGGER_STATIC_CONFIG.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#include "fakes.h"
+#include "logger.h"
+#include "mt_sink.h"
+#include "proxy_sink.h"
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+static_assert(LOGGER_STATIC_CONFIG);
+
+namespace {
+std::atomic<std::size_t> s_newCalls = 0;
+
+void* countedAllocation(std::size_t size, std::size_t alignment)
+{
+    s_newCalls.fetch_add(1, std::memory_order_relaxed);
+    void* pointer = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    if (pointer == nullptr) { throw std::bad_alloc(); }
+    return pointer;
+}
+}    // namespace
+
+// Every other form of new and delete goes through these.
+void* operator new(std::size_t size)
+{
+    return countedAllocation(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return countedAllocation(size, static_cast<std::size_t>(alignment));
+}
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+void operator delete(void* pointer, std::size_t /*size*/) noexcept
+{
+    std::free(pointer);
+}
+void operator delete(void* pointer, std::align_val_t /*alignment*/) noexcept
+{
+    std::free(pointer);
+}
+void operator delete(void* pointer, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept
+{
+    std::free(pointer);
+}
+
+namespace Logging {
+namespace {
+//! Allocations made by operator new and pvPortMalloc so far.
+std::size_t allocations()
+{
+    return s_newCalls.load(std::memory_order_relaxed) + Host::heapAllocations();
+}
+
+Fakes::CountingSink s_direct;
+Fakes::CountingSink s_target;
+}    // namespace
+
+TEST(StaticConfigTest, NothingIsAllocated)
+{
+    const std::uint8_t data[40] = {};
+    const std::size_t  before   = allocations();
+    {
+        MtSink<ProxySink> sink {&s_target};
+        // Let the sink's task start, it discards the messages until then.
+        vTaskDelay(pdMS_TO_TICKS(10));
+
+        Logger::addSink(sink);
+        Logger::addSink("USB", s_direct);
+        Logger::setLevel(Level::info);
+        Logger::setLevel("USB", Level::debug);
+        for (int i = 0; i < 100; i++) {
+            LOGI("MAIN", "message %d of %s", i, "the test");
+            LOGD("MAIN", "filtered out %d", i);
+            LOGI_F("USB", "checked {} {:#x}", i, 0x42U);
+            LOGD("USB", "debug %d", i);
+        }
+        LOG_BUFFER_HEXDUMP("MAIN", data, sizeof(data));
+        (void)Logger::snapshotStats();
+
+        for (int i = 0; i < 1000 && s_target.messages < 100; i++) {
+            vTaskDelay(1);
+        }
+        Logger::clearSinks("USB");
+        Logger::clearLevel("USB");
+        Logger::clearSinks();
+        Logger::clearLevel();
+    }
+    EXPECT_EQ(allocations(), before);
+    EXPECT_GE(s_target.messages, 100U);
+    EXPECT_EQ(s_direct.messages, 200U);
+}
+}    // namespace Logging
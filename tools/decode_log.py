@@ -0,0 +1,413 @@
+#!/usr/bin/env python3
+# Copyright (C) 2026 Samuel Martel
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+# License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+# version.
+"""Decodes the binary log stream produced with LOGGER_USE_BINARY_FORMAT=1.
+
+The format strings are read back from the `logger_fmt.*` sections of the firmware's ELF file, a message's format ID
+being the address of its format string.
+
+The messages of a sink with priority lanes (see priority_ring.h) are numbered by sequence records. The ones that were
+overtaken by a more severe message are marked with a `*`, or put back in order with --sort.
+
+Usage:
+    decode_log.py firmware.elf capture.bin
+    cat /dev/ttyACM0 | decode_log.py firmware.elf
+"""
+
+import argparse
+import heapq
+import re
+import struct
+import sys
+
+SYNC_BYTE = 0xA5
+# Logger::s_maxLength, the device doesn't write longer frames.
+MAX_FRAME_LENGTH = 512
+CHUNK_SIZE = 4096
+FORMAT_SECTION_PREFIX = "logger_fmt"
+SHT_NOBITS = 8
+RECORD_MESSAGE = 1
+RECORD_FORMAT_MESSAGE = 2
+RECORD_BLOB = 3
+RECORD_CLOCK_INFO = 4
+RECORD_SEQUENCE = 5
+RECORD_DROPPED = 6
+DUMP_HEX, DUMP_CHARS, DUMP_HEXDUMP = 0, 1, 2
+BYTES_PER_LINE = 16
+# Colour codes and other escape sequences added by the text sinks.
+ESCAPE = re.compile(rb"\x1b\[[0-9;]*[A-Za-z]")
+LEVEL_CHARS = {1: "E", 2: "W", 3: "I", 4: "D", 5: "T"}
+
+ARG_SIGNED = 0x10
+ARG_UNSIGNED = 0x20
+ARG_FLOATING = 0x30
+ARG_POINTER = 0x40
+ARG_STRING = 0x50
+
+# %[flags][width][.precision][length]conversion
+CONVERSION = re.compile(r"%([-+ #0]*)(\d+|\*)?(?:\.(\d+|\*))?(?:hh|h|ll|l|j|z|t|L)?([diouxXeEfFgGaAcsp%])")
+# Replacement field of a std::format-style format string, see format.h.
+FIELD = re.compile(r"\{\{|\}\}|\{(?::([^}]*))?\}")
+SPEC = re.compile(r"^((?:.?[<>^])?[-+ ]?#?0?\d*)(?:\.(\d+))?([a-zA-Z]?)$")
+
+
+class Elf:
+    """Just enough of an ELF reader to extract a section."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF":
+            raise ValueError(f"{path} is not an ELF file")
+        self.is64 = self.data[4] == 2
+        self.endian = "<" if self.data[5] == 1 else ">"
+
+    def sections(self):
+        """Returns (name, address, contents) for every section that has contents."""
+        e = self.endian
+        if self.is64:
+            shoff, = struct.unpack_from(e + "Q", self.data, 0x28)
+            shentsize, shnum, shstrndx = struct.unpack_from(e + "HHH", self.data, 0x3A)
+            entry = e + "IIQQQQIIQQ"
+        else:
+            shoff, = struct.unpack_from(e + "I", self.data, 0x20)
+            shentsize, shnum, shstrndx = struct.unpack_from(e + "HHH", self.data, 0x2E)
+            entry = e + "IIIIIIIIII"
+
+        headers = [struct.unpack_from(entry, self.data, shoff + i * shentsize) for i in range(shnum)]
+        strtab = headers[shstrndx]
+        sections = []
+        for name_offset, section_type, _, address, offset, size in (header[:6] for header in headers):
+            if section_type == SHT_NOBITS or size == 0:
+                continue
+            start = strtab[4] + name_offset
+            name = self.data[start:self.data.index(b"\0", start)].decode()
+            sections.append((name, address, self.data[offset:offset + size]))
+        return sections
+
+
+class Reader:
+    def __init__(self, payload, endian):
+        self.payload = payload
+        self.endian = endian
+        self.offset = 0
+
+    def done(self):
+        return self.offset >= len(self.payload)
+
+    def unpack(self, fmt):
+        values = struct.unpack_from(self.endian + fmt, self.payload, self.offset)
+        self.offset += struct.calcsize(self.endian + fmt)
+        return values[0] if len(values) == 1 else values
+
+    def bytes(self, length):
+        value = self.payload[self.offset:self.offset + length]
+        if len(value) != length:
+            raise ValueError("truncated record")
+        self.offset += length
+        return value
+
+    def string(self):
+        return self.bytes(self.unpack("B")).decode(errors="replace")
+
+    def arg(self):
+        arg_type = self.unpack("B")
+        kind, size = arg_type & 0xF0, arg_type & 0x0F
+        if kind == ARG_SIGNED:
+            return int.from_bytes(self.bytes(size), "little" if self.endian == "<" else "big", signed=True)
+        if kind in (ARG_UNSIGNED, ARG_POINTER):
+            return int.from_bytes(self.bytes(size), "little" if self.endian == "<" else "big")
+        if kind == ARG_FLOATING:
+            return self.unpack("d")
+        if kind == ARG_STRING:
+            return self.string()
+        raise ValueError(f"unknown argument type 0x{arg_type:02x}")
+
+
+def render(fmt, args):
+    """Applies a printf format string to the decoded arguments."""
+    args = iter(args)
+
+    def convert(match):
+        flags, width, precision, conversion = match.groups()
+        if conversion == "%":
+            return "%"
+        if width == "*":
+            width = str(next(args))
+        if precision == "*":
+            precision = str(next(args))
+        value = next(args)
+        if conversion == "p":
+            conversion, flags = "x", flags + "#"
+        elif conversion == "u":
+            conversion = "d"
+        elif conversion == "c" and isinstance(value, int):
+            value &= 0xFF
+        elif conversion in "diouxX" and isinstance(value, str):
+            conversion = "s"
+        spec = "%" + flags + (width or "") + ("." + precision if precision is not None else "") + conversion
+        return spec % value
+
+    try:
+        return CONVERSION.sub(convert, fmt)
+    except (StopIteration, TypeError, ValueError) as e:
+        return f"{fmt} <bad arguments: {e}>"
+
+
+def render_format(fmt, args):
+    """Applies a std::format-style format string to the decoded arguments, with the device's defaults."""
+    args = iter(args)
+
+    def convert(match):
+        if match.group(0) in ("{{", "}}"):
+            return match.group(0)[0]
+        head, precision, conversion = SPEC.match(match.group(1) or "").groups()
+        value = next(args)
+        if conversion == "p":
+            conversion, head = "x", head + "#"
+        elif conversion == "s" or isinstance(value, str):
+            value = str(value)
+        elif isinstance(value, float):
+            # Floats are fixed-point with 6 decimals by default on the device.
+            conversion, precision = conversion or "f", precision or "6"
+        elif conversion == "c":
+            value &= 0xFF
+        if isinstance(value, int):
+            precision = None
+        return format(value, head + ("." + precision if precision is not None else "") + conversion)
+
+    try:
+        return FIELD.sub(convert, fmt)
+    except (StopIteration, TypeError, ValueError, AttributeError) as e:
+        return f"{fmt} <bad arguments: {e}>"
+
+
+def render_dump(kind, address, data):
+    """Renders the lines of a buffer dump the way the device does it in text mode."""
+    lines = []
+    for offset in range(0, len(data), BYTES_PER_LINE):
+        line = data[offset:offset + BYTES_PER_LINE]
+        if kind == DUMP_HEX:
+            lines.append("".join(f"{byte:02x} " for byte in line))
+        elif kind == DUMP_CHARS:
+            # Each line stops at its first null byte, like a string would.
+            lines.append(line.split(b"\0", 1)[0].decode("latin-1"))
+        elif kind == DUMP_HEXDUMP:
+            text = f"0x{address + offset:x} "
+            for i in range(BYTES_PER_LINE):
+                if i % 8 == 0:
+                    text += " "
+                text += f" {line[i]:02x}" if i < len(line) else "   "
+            text += "  |" + "".join(chr(b) if 0x20 <= b < 0x7F else "." for b in line) + "|"
+            lines.append(text)
+        else:
+            raise ValueError(f"unknown dump kind {kind}")
+    return lines
+
+
+class Decoder:
+    def __init__(self, elf, tick_rate=None):
+        self.endian = elf.endian
+        # Given on the command line, or else by the clock info records. Defaults to a millisecond tick.
+        self.fixed_tick_rate = tick_rate
+        self.tick_rate = tick_rate or 1000
+        # Number given by the last sequence record, for the record that follows it.
+        self.next_sequence = None
+        # Sequence numbers unwrapped to keep increasing past 2^32.
+        self.last_sequence = None
+        self.unwrapped = 0
+        # Look in the format sections first, the linker script may have put them at addresses used by other sections.
+        sections = elf.sections()
+        self.sections = [s for s in sections if s[0].startswith(FORMAT_SECTION_PREFIX)]
+        self.sections += [s for s in sections if not s[0].startswith(FORMAT_SECTION_PREFIX) and s[1] != 0]
+        if not any(s[0].startswith(FORMAT_SECTION_PREFIX) for s in sections):
+            # Still fine for the buffer dumps of LOGGER_USE_BINARY_BUFFER_DUMPS=1 in a text stream.
+            sys.stderr.write("warning: no format section in the ELF file, was it built with LOGGER_USE_BINARY_FORMAT=1?\n")
+
+    def format_string(self, format_id):
+        for _, address, contents in self.sections:
+            if address <= format_id < address + len(contents):
+                start = format_id - address
+                end = contents.find(b"\0", start)
+                if end != -1:
+                    return contents[start:end].decode(errors="replace")
+        return f"<unknown format 0x{format_id:x}>"
+
+    def record(self, payload):
+        """Returns the sequence number of the record, or None, and its text."""
+        reader = Reader(payload, self.endian)
+        record_type = reader.unpack("B")
+        if record_type == RECORD_SEQUENCE:
+            self.next_sequence = reader.unpack("I")
+            return None, ""
+        sequence, self.next_sequence = self.unwrap(self.next_sequence), None
+        return sequence, self.render(reader, record_type)
+
+    def unwrap(self, sequence):
+        if sequence is None:
+            return None
+        if self.last_sequence is not None:
+            delta = (sequence - self.last_sequence) & 0xFFFFFFFF
+            self.unwrapped += delta - (1 << 32) if delta >= 1 << 31 else delta
+        self.last_sequence = sequence
+        return self.unwrapped
+
+    def render(self, reader, record_type):
+        if record_type in (RECORD_MESSAGE, RECORD_FORMAT_MESSAGE):
+            level, timestamp, format_id = reader.unpack("BQI")
+            tag = reader.string()
+            args = []
+            while not reader.done():
+                args.append(reader.arg())
+            renderer = render if record_type == RECORD_MESSAGE else render_format
+            message = renderer(self.format_string(format_id), args)
+            return f"{LEVEL_CHARS.get(level, '?')} ({self.time(timestamp)}) [{tag}] {message}\r\n"
+        if record_type == RECORD_BLOB:
+            level, timestamp, kind, address_size = reader.unpack("BQBB")
+            address = int.from_bytes(reader.bytes(address_size), "little" if self.endian == "<" else "big")
+            tag = reader.string()
+            length = reader.unpack("H")
+            prefix = f"{LEVEL_CHARS.get(level, '?')} ({self.time(timestamp)}) [{tag}] "
+            return "".join(prefix + line + "\r\n" for line in render_dump(kind, address, reader.bytes(length)))
+        if record_type == RECORD_DROPPED:
+            timestamp, count = reader.unpack("QI")
+            return f"E ({self.time(timestamp)}) Dropped {count} messages!\r\n"
+        if record_type == RECORD_CLOCK_INFO:
+            tick_rate = reader.unpack("Q")
+            if not self.fixed_tick_rate and tick_rate != 0:
+                self.tick_rate = tick_rate
+            return ""
+        raise ValueError(f"unknown record type {record_type}")
+
+    def time(self, timestamp):
+        """Milliseconds like the device prints them, with the microseconds when the clock has them."""
+        if self.tick_rate == 1000:
+            return f"{timestamp:05d}"
+        microseconds = timestamp * 1_000_000 // self.tick_rate
+        return f"{microseconds // 1000:05d}.{microseconds % 1000:03d}"
+
+    def stream(self, chunks):
+        """Yields the sequence number, or None, and the text of the decoded records, and the text around them without
+        its colour codes. Anything else that is not a valid frame is skipped. The input is decoded as it arrives, a
+        frame or a line cut at the end of a chunk being kept for the next one."""
+        data = b""
+        for chunk in chunks:
+            data += chunk
+            consumed = yield from self.decode(data, final=False)
+            data = data[consumed:]
+        yield from self.decode(data, final=True)
+
+    def decode(self, data, final):
+        """Decodes the frames of `data` and the text around them. Returns how much of it was decoded: everything if
+        `final`, else up to the end of the last full line before a frame that is still incomplete."""
+        offset = 0
+        text_start = 0
+        while True:
+            offset = data.find(bytes([SYNC_BYTE]), offset)
+            if offset == -1:
+                offset = len(data)
+                break
+            if offset + 3 > len(data):
+                if final:
+                    offset = len(data)
+                break
+            length, = struct.unpack_from(self.endian + "H", data, offset + 1)
+            if length + 4 > MAX_FRAME_LENGTH:
+                offset += 1
+                continue
+            end = offset + 3 + length
+            if end + 1 > len(data):
+                if final:
+                    offset += 1
+                    continue
+                break
+            payload = data[offset + 3:end]
+            checksum = 0
+            for byte in payload:
+                checksum ^= byte
+            if checksum != data[end]:
+                offset += 1
+                continue
+            try:
+                sequence, record = self.record(payload)
+            except (ValueError, struct.error):
+                offset += 1
+                continue
+            yield from self.text(data[text_start:offset])
+            if record:
+                yield sequence, record
+            offset = end + 1
+            text_start = offset
+        if final:
+            yield from self.text(data[text_start:])
+            return len(data)
+        # Keep the end of a line for the next chunk, in case a character or a colour code was cut. Unless it isn't
+        # made of lines.
+        end = data.rfind(b"\n", text_start, offset) + 1
+        if end == 0:
+            if offset - text_start <= MAX_FRAME_LENGTH:
+                return text_start
+            end = offset
+        yield from self.text(data[text_start:end])
+        return end
+
+    @staticmethod
+    def text(data):
+        text = ESCAPE.sub(b"", data)
+        if text.strip():
+            yield None, text.decode(errors="replace")
+
+
+def mark_late(records):
+    """Prefixes the lines of the records numbered below one already shown with a `*`."""
+    newest = None
+    for sequence, text in records:
+        if sequence is not None:
+            if newest is not None and sequence < newest:
+                text = "".join("* " + line for line in text.splitlines(keepends=True))
+            newest = sequence if newest is None else max(newest, sequence)
+        yield text
+
+
+def sort_records(records, window):
+    """Puts the numbered records back in order, holding up to `window` of them. The other ones flush the held
+    records."""
+    held = []
+    for sequence, text in records:
+        if sequence is None:
+            while held:
+                yield heapq.heappop(held)[1]
+            yield text
+            continue
+        heapq.heappush(held, (sequence, text))
+        if len(held) > window:
+            yield heapq.heappop(held)[1]
+    while held:
+        yield heapq.heappop(held)[1]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="firmware ELF file, used to look up the format strings")
+    parser.add_argument("input", nargs="?", default="-", help="captured stream, '-' for stdin (default)")
+    parser.add_argument("--tick-rate", type=int, help="frequency of the timestamps in Hz, overriding the one sent by "
+                                                      "the device (see Logger::setClock)")
+    parser.add_argument("--sort", type=int, nargs="?", const=256, metavar="WINDOW",
+                        help="put the numbered messages back in the order they were logged, looking up to WINDOW "
+                             "messages ahead (default: 256)")
+    args = parser.parse_args()
+
+    decoder = Decoder(Elf(args.elf), args.tick_rate)
+    with open(sys.stdin.fileno() if args.input == "-" else args.input, "rb", closefd=args.input != "-") as f:
+        # read1 returns what is available rather than waiting for a full chunk, for live views.
+        records = decoder.stream(iter(lambda: f.read1(CHUNK_SIZE), b""))
+        lines = sort_records(records, args.sort) if args.sort else mark_late(records)
+        for line in lines:
+            sys.stdout.write(line)
+            sys.stdout.flush()
+
+if __name__ == "__main__":
+    main()
@@ -17,65 +17,53 @@
 
 #include "uart_sink.h"
 
+#include "colors.h"
+
+#include <cstring>
 #include <string_view>
 
 namespace Logging {
+void UartSink::onWrite(Level level, const char* string, size_t length)
+{
+    auto color = colorStrFromLevel(level);
+    if (!color.empty()) { transmit(color.data(), color.size()); }
+    transmit(string, length);
+    if (!color.empty()) { transmit(s_resetColor.data(), s_resetColor.size()); }
+}
 
-#define LOG_COLOR_BLACK  ";30"
-#define LOG_COLOR_RED    ";31"
-#define LOG_COLOR_GREEN  ";32"
-#define LOG_COLOR_BROWN  ";33"
-#define LOG_COLOR_BLUE   ";34"
-#define LOG_COLOR_PURPLE ";35"
-#define LOG_COLOR_CYAN   ";36"
-#define LOG_COLOR(COLOR) "\033[0" COLOR "m"
-#define LOG_BOLD(COLOR)  "\033[1" COLOR "m"
-#define LOG_RESET_COLOR  "\033[0m"
-#define LOG_COLOR_E      LOG_COLOR(LOG_COLOR_RED)
-#define LOG_COLOR_W      LOG_COLOR(LOG_COLOR_BROWN)
-#define LOG_COLOR_I      LOG_COLOR(LOG_COLOR_GREEN)
-#define LOG_COLOR_D      LOG_RESET_COLOR
-#define LOG_COLOR_T      LOG_COLOR(LOG_COLOR_CYAN)
-#define LOG_BELL_E
-#define LOG_BELL_W
-#define LOG_BELL_I
-#define LOG_BELL_D
-#define LOG_BELL_T
-
-namespace {
-constexpr std::string_view s_errorColor   = LOG_COLOR_E LOG_BELL_E;
-constexpr std::string_view s_warningColor = LOG_COLOR_W LOG_BELL_W;
-constexpr std::string_view s_infoColor    = LOG_COLOR_I LOG_BELL_I;
-constexpr std::string_view s_debugColor   = LOG_COLOR_D LOG_BELL_D;
-constexpr std::string_view s_traceColor   = LOG_COLOR_T LOG_BELL_T;
+void UartSink::onWriteBatch(const Message* messages, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; i++) {
+        auto color = colorStrFromLevel(messages[i].level);
+        appendToBatch(color);
+        appendToBatch({messages[i].string, messages[i].length});
+        if (!color.empty()) { appendToBatch(s_resetColor); }
+    }
+    flushBatch();
+}
 
-constexpr std::string_view s_resetColor = LOG_RESET_COLOR;
+void UartSink::transmit(const char* data, std::size_t length)
+{
+    HAL_UART_Transmit(m_uart, reinterpret_cast<const uint8_t*>(data), length, HAL_MAX_DELAY);
+}
 
-constexpr std::string_view colorStrFromLevel(Level level)
+void UartSink::appendToBatch(std::string_view data)
 {
-    switch (level) {
-        case Level::error: return s_errorColor;
-        case Level::warning: return s_warningColor;
-        case Level::info: return s_infoColor;
-        case Level::debug: return s_debugColor;
-        case Level::trace: return s_traceColor;
-        case Level::all:
-        case Level::none:
-        default: return "";
+    if (m_batchLength + data.size() > s_batchBufferSize) { flushBatch(); }
+    if (data.size() > s_batchBufferSize) {
+        // Wouldn't fit even in an empty buffer, send it as is.
+        transmit(data.data(), data.size());
+        return;
     }
+    std::memcpy(&m_batchBuffer[m_batchLength], data.data(), data.size());
+    m_batchLength += data.size();
 }
-}    // namespace
 
-void UartSink::onWrite(Level level, const char* string, size_t length)
+void UartSink::flushBatch()
 {
-    auto color = colorStrFromLevel(level);
-    if (!color.empty()) {
-        HAL_UART_Transmit(m_uart, reinterpret_cast<const uint8_t*>(color.data()), color.size(), HAL_MAX_DELAY);
-    }
-    HAL_UART_Transmit(m_uart, reinterpret_cast<const uint8_t*>(string), length, HAL_MAX_DELAY);
-    if (!color.empty()) {
-        HAL_UART_Transmit(
-          m_uart, reinterpret_cast<const uint8_t*>(s_resetColor.data()), s_resetColor.size(), HAL_MAX_DELAY);
+    if (m_batchLength != 0) {
+        transmit(&m_batchBuffer[0], m_batchLength);
+        m_batchLength = 0;
     }
 }
 }    // namespace Logging
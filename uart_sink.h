@@ -20,12 +20,21 @@
 #include "sink.h"
 #include "usart.h"
 
+#include <cstddef>
+#include <string_view>
+
 namespace Logging {
 
 class UartSink : public Sink {
 private:
+    //! Size of the buffer where batches are packed before being transmitted.
+    static constexpr std::size_t s_batchBufferSize = 256;
+
     UART_HandleTypeDef* m_uart;
 
+    char        m_batchBuffer[s_batchBufferSize];
+    std::size_t m_batchLength = 0;
+
 public:
     explicit UartSink(UART_HandleTypeDef* handle) : m_uart(handle) {}
     UartSink(const UartSink&)            = delete;
@@ -36,6 +45,17 @@ public:
     ~UartSink() override = default;
 
     void onWrite(Level level, const char* string, size_t length) override;
+    /**
+     * Packs the messages and their colors in a buffer, transmitting it only when it is full.
+     *
+     * @attention Not reentrant, meant to be called by a single task (e.g. MtSink's).
+     */
+    void onWriteBatch(const Message* messages, std::size_t count) override;
+
+private:
+    void transmit(const char* data, std::size_t length);
+    void appendToBatch(std::string_view data);
+    void flushBatch();
 };
 
 using MtUartSink = MtSink<UartSink>;
@@ -0,0 +1,61 @@
+/**
+ * @file    uart_transport.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Interface between the UART sinks and the hardware.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#ifndef VENDOR_LOGGING_UART_TRANSPORT_H
+#define VENDOR_LOGGING_UART_TRANSPORT_H
+
+#include <cstddef>
+
+namespace Logging {
+/**
+ * Sends bytes in the background, e.g. with a DMA. Keeping the HAL behind this interface lets the sinks be exercised on
+ * a host with a fake transport.
+ */
+class UartTransport {
+public:
+    using CompletionCallback = void (*)(void* context);
+
+    virtual ~UartTransport() = default;
+
+    /**
+     * Starts sending the data. The data must stay untouched until onTransmitComplete is called.
+     * @return True if the transfer was started.
+     */
+    virtual bool startTransmit(const char* data, std::size_t length) = 0;
+
+    //! Sets the function called when a transfer is complete. Only one listener is supported.
+    void setCompletionCallback(CompletionCallback callback, void* context)
+    {
+        m_callback = callback;
+        m_context  = context;
+    }
+
+    /**
+     * Must be called when the current transfer is complete, usually from the TX complete interrupt.
+     */
+    void onTransmitComplete()
+    {
+        if (m_callback != nullptr) { m_callback(m_context); }
+    }
+
+private:
+    CompletionCallback m_callback = nullptr;
+    void*              m_context  = nullptr;
+};
+}    // namespace Logging
+
+#endif    // VENDOR_LOGGING_UART_TRANSPORT_H
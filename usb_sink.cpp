@@ -16,101 +16,110 @@
  */
 #include "usb_sink.h"
 
+#include "colors.h"
+
 #include <task.h>
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <string_view>
 
 namespace Logging {
-#define LOG_COLOR_BLACK  ";30"
-#define LOG_COLOR_RED    ";31"
-#define LOG_COLOR_GREEN  ";32"
-#define LOG_COLOR_BROWN  ";33"
-#define LOG_COLOR_BLUE   ";34"
-#define LOG_COLOR_PURPLE ";35"
-#define LOG_COLOR_CYAN   ";36"
-#define LOG_COLOR(COLOR) "\033[0" COLOR "m"
-#define LOG_BOLD(COLOR)  "\033[1" COLOR "m"
-#define LOG_RESET_COLOR  "\033[0m"
-#define LOG_COLOR_E      LOG_COLOR(LOG_COLOR_RED)
-#define LOG_COLOR_W      LOG_COLOR(LOG_COLOR_BROWN)
-#define LOG_COLOR_I      LOG_COLOR(LOG_COLOR_GREEN)
-#define LOG_COLOR_D      LOG_RESET_COLOR
-#define LOG_COLOR_T      LOG_COLOR(LOG_COLOR_CYAN)
-// #define LOG_BELL_E       "\a"
-#define LOG_BELL_E
-#define LOG_BELL_W
-#define LOG_BELL_I
-#define LOG_BELL_D
-#define LOG_BELL_T
-
-namespace {
-constexpr std::string_view s_errorColor   = LOG_COLOR_E LOG_BELL_E;
-constexpr std::string_view s_warningColor = LOG_COLOR_W LOG_BELL_W;
-constexpr std::string_view s_infoColor    = LOG_COLOR_I LOG_BELL_I;
-constexpr std::string_view s_debugColor   = LOG_COLOR_D LOG_BELL_D;
-constexpr std::string_view s_traceColor   = LOG_COLOR_T LOG_BELL_T;
-
-constexpr std::string_view s_resetColor = LOG_RESET_COLOR;
-
-constexpr std::string_view colorStrFromLevel(Level level)
+bool HalCdcTransport::queue(const char* data, std::size_t length)
 {
-    switch (level) {
-        case Level::error: return s_errorColor;
-        case Level::warning: return s_warningColor;
-        case Level::info: return s_infoColor;
-        case Level::debug: return s_debugColor;
-        case Level::trace: return s_traceColor;
-        case Level::all:
-        case Level::none:
-        default: return "";
-    }
+    return CDC_Queue(m_usb, reinterpret_cast<uint8_t*>(const_cast<char*>(data)), length) == USBD_OK;
+}
+
+void HalCdcTransport::send()
+{
+    CDC_SendQueue(m_usb);
 }
-}    // namespace
 
 void UsbSink::onWrite(Level level, const char* string, size_t length)
+{
+    reportDroppedMessages();
+    appendMessage(level, string, length);
+    flush();
+}
+
+void UsbSink::onWriteBatch(const Message* messages, std::size_t count)
+{
+    reportDroppedMessages();
+    for (std::size_t i = 0; i < count; i++) {
+        appendMessage(messages[i].level, messages[i].string, messages[i].length);
+    }
+    // The last packet is most likely partial, give the next batch a chance to fill it.
+}
+
+void UsbSink::flush()
+{
+    if (m_packetLength != 0) { queuePacket(); }
+    m_transport->send();
+}
+
+void UsbSink::reportDroppedMessages()
 {
     if (m_droppedMessages != 0) {
         char        msg[32];
-        std::size_t len   = std::snprintf(&msg[0], sizeof(msg), "Dropped %d messages!\n\r", m_droppedMessages);
+        std::size_t len   = std::snprintf(&msg[0],
+                                        sizeof(msg),
+                                        "Dropped %u messages!\r\n",
+                                        static_cast<unsigned int>(m_droppedMessages));
         m_droppedMessages = 0;
-        onWrite(Level::error, &msg[0], len);
+        appendMessage(Level::error, &msg[0], std::min(len, sizeof(msg) - 1));
     }
+}
 
+void UsbSink::appendMessage(Level level, const char* string, size_t length)
+{
+    m_messageId++;
     auto color = colorStrFromLevel(level);
+    append(color);
+    append({string, length});
+    if (!color.empty()) { append(s_resetColor); }
+}
 
-    if (!color.empty()) { queueData(color.data(), color.size()); }
-
-    const char* ptr = string;
-    while (length != 0) {
-        std::size_t chunkSize = std::min(m_bufferSize, length);
-        queueData(ptr, length);
-        length -= chunkSize;
-        ptr += chunkSize;
-    }
+void UsbSink::append(std::string_view data)
+{
+    while (!data.empty()) {
+        if (m_packetLength == 0) { m_packetFirstMessage = m_messageId; }
 
-    if (!color.empty()) { queueData(s_resetColor.data(), s_resetColor.size()); }
+        std::size_t chunkSize = std::min(data.size(), m_packetSize - m_packetLength);
+        std::memcpy(&m_packet[m_packetLength], data.data(), chunkSize);
+        m_packetLength += chunkSize;
+        data.remove_prefix(chunkSize);
 
-    CDC_SendQueue(m_usb);
+        if (m_packetLength == m_packetSize) {
+            queuePacket();
+            m_transport->send();
+        }
+    }
 }
 
-bool UsbSink::queueData(const char* data, std::size_t length)
+bool UsbSink::queuePacket()
 {
-//    TickType_t ticksToWait = s_maxWaitTime;
-//    TimeOut_t  timeout;
-//    vTaskSetTimeOutState(&timeout);
-
-//    while (CDC_Queue(m_usb, reinterpret_cast<uint8_t*>(const_cast<char*>(data)), length) != USBD_OK) {
-//        if (xTaskCheckForTimeOut(&timeout, &ticksToWait) == pdFALSE) {
-//            // No timeout yet.
-//            vTaskDelay(pdMS_TO_TICKS(1));    // Block the task for 1ms, hoping to clear the USB.
-//        }
-//        else {
-//            ++m_droppedMessages;
-//            return true;
-//        }
-//    }
-    CDC_Queue(m_usb, reinterpret_cast<uint8_t*>(const_cast<char*>(data)), length);
-
-    return false;
+    TickType_t ticksToWait = s_maxWaitTime;
+    TimeOut_t  timeout;
+    vTaskSetTimeOutState(&timeout);
+
+    bool queued = m_transport->queue(&m_packet[0], m_packetLength);
+    while (!queued) {
+        if (xTaskCheckForTimeOut(&timeout, &ticksToWait) != pdFALSE) {
+            // Count each message of the packet once, even if it started in a packet that was dropped already.
+            std::uint32_t first = std::max(m_packetFirstMessage, m_lastDroppedMessage + 1);
+            m_droppedMessages += m_messageId - first + 1;
+            stats().drop(DropCause::transport, m_messageId - first + 1);
+            m_lastDroppedMessage = m_messageId;
+            break;
+        }
+        // Make sure that what's already queued is on its way, then give it some time to drain.
+        m_transport->send();
+        vTaskDelay(pdMS_TO_TICKS(1));
+        queued = m_transport->queue(&m_packet[0], m_packetLength);
+    }
+
+    m_packetLength = 0;
+    return queued;
 }
 }    // namespace Logging
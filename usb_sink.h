@@ -18,23 +18,78 @@
 
 #ifndef VENDOR_LOGGING_USB_SINK_H
 #define VENDOR_LOGGING_USB_SINK_H
+#include "cdc_transport.h"
 #include "mt_sink.h"
 #include "sink.h"
 #include "usbd_cdc_if.h"
 
 #include <FreeRTOS.h>
 
+#include <cstdint>
+#include <string_view>
+
 namespace Logging {
+//! Transport using the CDC class driver's queue.
+class HalCdcTransport : public CdcTransport {
+    CDC_DeviceInfo* m_usb = nullptr;
+
+public:
+    explicit HalCdcTransport(CDC_DeviceInfo* handle) : m_usb(handle) {}
+
+    bool queue(const char* data, std::size_t length) override;
+    void send() override;
+};
+
+/**
+ * Coalesces the messages into full USB packets before queuing them.
+ *
+ * A packet is queued as soon as it is full. onWrite sends the partial packet right away, while onWriteBatch keeps it
+ * until the next batch fills it or flush() is called, which MtSink does once its queue has been idle for a while.
+ *
+ * When the CDC queue is full, the sink waits up to s_maxWaitTime for it to drain, then drops the packet. Every message
+ * that had bytes in a dropped packet is counted once, as a transport drop in the statistics, and reported in the next
+ * write.
+ */
 class UsbSink : public Sink {
+public:
+    static constexpr std::size_t s_fullSpeedPacketSize = 64;
+    static constexpr std::size_t s_highSpeedPacketSize = 512;
+
 private:
-    static constexpr std::size_t s_maxWaitTime    = pdMS_TO_TICKS(100);
-    struct CDC_DeviceInfo*              m_usb            = nullptr;
+    static constexpr TickType_t s_maxWaitTime = pdMS_TO_TICKS(100);
+
+    HalCdcTransport m_halTransport {nullptr};
+    CdcTransport*   m_transport = nullptr;
 
-    std::size_t m_bufferSize      = 0;
-    std::size_t m_droppedMessages = 0;
+    char        m_packet[s_highSpeedPacketSize];
+    std::size_t m_packetSize   = s_fullSpeedPacketSize;
+    std::size_t m_packetLength = 0;
+
+    // Messages are numbered so that the ones spanning several dropped packets are only counted once.
+    std::uint32_t m_messageId          = 0;    //!< ID of the message being written.
+    std::uint32_t m_packetFirstMessage = 0;    //!< ID of the first message with bytes in the packet.
+    std::uint32_t m_lastDroppedMessage = 0;
+    std::size_t   m_droppedMessages    = 0;
 
 public:
-    explicit UsbSink(CDC_DeviceInfo* handle) : m_usb(handle), m_bufferSize(CDC_GetTxBufferSize(handle)) {}
+    /**
+     * @param handle CDC interface to send on.
+     * @param packetSize Size of the packets of the interface, s_fullSpeedPacketSize or s_highSpeedPacketSize.
+     */
+    explicit UsbSink(CDC_DeviceInfo* handle, std::size_t packetSize = s_fullSpeedPacketSize)
+    : m_halTransport(handle), m_transport(&m_halTransport), m_packetSize(packetSize)
+    {
+        configASSERT(packetSize <= s_highSpeedPacketSize && packetSize <= CDC_GetTxBufferSize(handle));
+    }
+    /**
+     * @param transport Transport to send with, must outlive the sink.
+     * @param packetSize Size of the packets of the interface, s_fullSpeedPacketSize or s_highSpeedPacketSize.
+     */
+    explicit UsbSink(CdcTransport& transport, std::size_t packetSize = s_fullSpeedPacketSize)
+    : m_transport(&transport), m_packetSize(packetSize)
+    {
+        configASSERT(packetSize <= s_highSpeedPacketSize);
+    }
     UsbSink(const UsbSink&)            = delete;
     UsbSink(UsbSink&&)                 = delete;
     UsbSink& operator=(const UsbSink&) = delete;
@@ -43,15 +98,19 @@ public:
     ~UsbSink() override = default;
 
     void onWrite(Level level, const char* string, std::size_t length) override;
+    void onWriteBatch(const Message* messages, std::size_t count) override;
+    void flush() override;
 
 private:
+    void reportDroppedMessages();
+    void appendMessage(Level level, const char* string, std::size_t length);
+    void append(std::string_view data);
+
     /**
-     * Tries to send data over USB.
-     * @param data
-     * @param length
-     * @return True if operation failed, false otherwise.
+     * Queues the packet, waiting for room in the CDC queue for up to s_maxWaitTime.
+     * @return True if the packet was queued, false if it was dropped.
      */
-    bool queueData(const char* data, std::size_t length);
+    bool queuePacket();
 };
 
 using MtUsbSink = MtSink<UsbSink>;